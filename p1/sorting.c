@@ -96,3 +96,117 @@ int min(int* array, int ip, int iu)
   return min;
 }
 
+/**
+ * @brief Ordena de menor a mayor un array por inserción. Es adaptativo: 
+ * con el array ya ordenado realiza iu-ip comparaciones
+ * 
+ * @param array el array a ordenar
+ * @param ip primer índice del array
+ * @param iu último índice del array
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int InsertSort(int* array, int ip, int iu)
+{
+  int i, j, k, count;
+
+  if(array == NULL || ip > iu) return ERR;
+
+  count = 0;
+  for(i = ip+1; i <= iu; i++) {
+    k = array[i];
+    for(j = i-1; j >= ip; j--) {
+      count++;
+      if(array[j] <= k) break;
+      array[j+1] = array[j];
+    }
+    array[j+1] = k;
+  }
+
+  return count;
+}
+
+/**
+ * @brief Ordena de menor a mayor un array por inserción binaria: la 
+ * posición de cada elemento se busca con búsqueda binaria en la parte ya 
+ * ordenada, por lo que hace O(N log N) comparaciones aunque mueva O(N^2) 
+ * elementos
+ * 
+ * @param array el array a ordenar
+ * @param ip primer índice del array
+ * @param iu último índice del array
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int BinInsertSort(int* array, int ip, int iu)
+{
+  int i, j, lo, hi, m, k, count;
+
+  if(array == NULL || ip > iu) return ERR;
+
+  count = 0;
+  for(i = ip+1; i <= iu; i++) {
+    k = array[i];
+    /* Primera posición con un elemento mayor que k, para que sea estable */
+    lo = ip;
+    hi = i;
+    while(lo < hi) {
+      m = (lo+hi)/2;
+      count++;
+      if(k < array[m]) hi = m;
+      else lo = m+1;
+    }
+    for(j = i; j > lo; j--) {
+      array[j] = array[j-1];
+    }
+    array[lo] = k;
+  }
+
+  return count;
+}
+
+/**
+ * @brief Ordena de menor a mayor un array con Shell sort, usando la 
+ * secuencia de saltos de Ciura (1, 4, 10, 23, 57, 132, 301, 701, 1750) 
+ * extendida multiplicando por 2.25
+ * 
+ * @param array el array a ordenar
+ * @param ip primer índice del array
+ * @param iu último índice del array
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int ShellSort(int* array, int ip, int iu)
+{
+  int ciura[] = {1, 4, 10, 23, 57, 132, 301, 701, 1750};
+  int gaps[64];
+  int n_gaps, g, gap, i, j, k, count;
+
+  if(array == NULL || ip > iu) return ERR;
+
+  for(n_gaps = 0; n_gaps < 9 && ciura[n_gaps] < iu-ip+1; n_gaps++) {
+    gaps[n_gaps] = ciura[n_gaps];
+  }
+  if(n_gaps == 9) {
+    while(gaps[n_gaps-1] < (iu-ip+1) / 2.25) {
+      gaps[n_gaps] = (int)(gaps[n_gaps-1] * 2.25);
+      n_gaps++;
+    }
+  }
+
+  count = 0;
+  for(g = n_gaps-1; g >= 0; g--) {
+    gap = gaps[g];
+    for(i = ip+gap; i <= iu; i++) {
+      k = array[i];
+      for(j = i-gap; j >= ip; j -= gap) {
+        count++;
+        if(array[j] <= k) break;
+        array[j+gap] = array[j];
+      }
+      array[j+gap] = k;
+    }
+  }
+
+  return count;
+}
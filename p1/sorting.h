@@ -28,5 +28,9 @@ int SelectSort(int* array, int ip, int iu);
 int SelectSortInv(int* array, int ip, int iu);
 int min(int* array, int ip, int iu);
 
+int InsertSort(int* array, int ip, int iu);
+int BinInsertSort(int* array, int ip, int iu);
+int ShellSort(int* array, int ip, int iu);
+
 
 #endif
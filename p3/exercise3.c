@@ -0,0 +1,128 @@
+/***********************************************************/
+/* Program: exercise3 Date:                             */
+/* Authors:                                                */
+/*                                                         */
+/* Program that sorts a binary file of ints that does not  */
+/* have to fit in memory and reports the throughput        */
+/*                                                         */
+/* Input: Command line                                     */
+/* -size: number of ints of the generated input file       */
+/* -mem: memory used by the sort, in KB                    */
+/* -inputFile: Name of the input file                      */
+/* -outputFile: Name of the output file                    */
+/*                                                         */
+/* Output: 0 if there was an error                         */
+/*        -1 otherwise                                     */
+/***********************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "permutations.h"
+#include "sorting.h"
+#include "extsort.h"
+
+/* enteros que se generan o comprueban en cada bloque */
+#define BLOCK 65536
+
+int main(int argc, char** argv)
+{
+  int i, size, mem, n, ant, desordenado;
+  int *bloque;
+  long total;
+  char in_name[256], out_name[256];
+  FILE *f;
+  EXT_STATS stats;
+
+  srand(time(NULL));
+
+  if (argc != 9) {
+    fprintf(stderr, "Error in the input parameters:\n\n");
+    fprintf(stderr, "%s -size <int> -mem <int> -inputFile <string> -outputFile <string>\n", argv[0]);
+    fprintf(stderr, "Where:\n");
+    fprintf(stderr, "-size: number of ints of the generated input file\n");
+    fprintf(stderr, "-mem: memory used by the sort, in KB\n");
+    fprintf(stderr, "-inputFile: Input file name\n");
+    fprintf(stderr, "-outputFile: Output file name\n");
+    exit(-1);
+  }
+
+  printf("Practice number 3, external sort\n");
+  printf("Done by: Miguel Lozano and Eduardo Junoy\n");
+  printf("Group: 1263\n");
+
+  /* check the command line */
+  size = mem = 0;
+  for(i = 1; i < argc ; i++) {
+    if (strcmp(argv[i], "-size") == 0) {
+      size = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-mem") == 0) {
+      mem = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-inputFile") == 0) {
+      strcpy(in_name, argv[++i]);
+    } else if (strcmp(argv[i], "-outputFile") == 0) {
+      strcpy(out_name, argv[++i]);
+    } else {
+      fprintf(stderr, "Parameter %s is invalid\n", argv[i]);
+      exit(-1);
+    }
+  }
+
+  bloque = (int*)malloc(sizeof(bloque[0]) * BLOCK);
+  if (bloque == NULL) {
+    printf("Error: No hay memoria\n");
+    exit(-1);
+  }
+
+  /* generamos la entrada por bloques */
+  f = fopen(in_name, "wb");
+  if (f == NULL) {
+    printf("Error: could not create %s\n", in_name);
+    free(bloque);
+    exit(-1);
+  }
+  for(total = 0; total < size; total += n) {
+    n = (size-total < BLOCK) ? size-total : BLOCK;
+    for(i = 0; i < n; i++) bloque[i] = random_num(0, size);
+    fwrite(bloque, sizeof(bloque[0]), n, f);
+  }
+  fclose(f);
+
+  if (extsort(in_name, out_name, (size_t)mem*1024, quicksort, &stats) == ERR) {
+    printf("Error in function extsort\n");
+    free(bloque);
+    exit(-1);
+  }
+
+  /* comprobamos la salida */
+  f = fopen(out_name, "rb");
+  if (f == NULL) {
+    printf("Error: could not open %s\n", out_name);
+    free(bloque);
+    exit(-1);
+  }
+  desordenado = 0;
+  ant = 0;
+  total = 0;
+  while((n = fread(bloque, sizeof(bloque[0]), BLOCK, f)) > 0) {
+    for(i = 0; i < n; i++) {
+      if(total+i > 0 && bloque[i] < ant) desordenado = 1;
+      ant = bloque[i];
+    }
+    total += n;
+  }
+  fclose(f);
+  free(bloque);
+
+  if (desordenado || total != size) {
+    printf("Error: the output file is not sorted\n");
+    exit(-1);
+  }
+
+  printf("%ld ints, %d runs, %d merge passes\n", stats.n_elems, stats.n_runs, stats.n_passes);
+  printf("%.0f basic op., %.3f s, %.2f MB/s\n", stats.n_obs, stats.time, stats.mb_s);
+  printf("Correct output \n");
+
+  return 0;
+}
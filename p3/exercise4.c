@@ -0,0 +1,248 @@
+/***********************************************************/
+/* Program: exercise4 Date:                             */
+/* Authors:                                                */
+/*                                                         */
+/* Program that checks that partition_simd and             */
+/* quicksort_simd give the same results as the scalar      */
+/* partition and quicksort, and that quickselect and       */
+/* partial_sort are correct, also with repeated keys       */
+/*                                                         */
+/* Input: Command line                                     */
+/* -size: maximum number of elements of the tables         */
+/* -n_times: tables tried for each size and kind of input  */
+/*                                                         */
+/* Output: 0 if there was an error                         */
+/*        -1 otherwise                                     */
+/***********************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "permutations.h"
+#include "sorting.h"
+
+/* tipos de entrada que se prueban */
+#define N_KINDS 4
+
+/**
+ * @brief Rellena una tabla de n elementos según el tipo de entrada:
+ * 0 permutación, 1 pocos valores distintos, 2 todos iguales, 3 ordenada
+ * con repetidos
+ *
+ * @param tabla la tabla a rellenar
+ * @param n número de elementos
+ * @param kind tipo de entrada
+*/
+static void fill(int* tabla, int n, int kind)
+{
+  int i, *perm;
+
+  if (kind == 0 && (perm = generate_perm(n)) != NULL) {
+    memcpy(tabla, perm, sizeof(tabla[0]) * n);
+    free(perm);
+    return;
+  }
+  for(i = 0; i < n; i++) {
+    if (kind == 2) tabla[i] = 7;
+    else if (kind == 3) tabla[i] = i/3;
+    else tabla[i] = random_num(0, 3);
+  }
+}
+
+/**
+ * @brief Compara dos enteros para qsort
+ *
+ * @param a primer entero
+ * @param b segundo entero
+ *
+ * @return negativo, 0 o positivo si a es menor, igual o mayor que b
+*/
+static int cmp_int(const void *a, const void *b)
+{
+  int x = *(const int*)a, y = *(const int*)b;
+
+  return (x > y) - (x < y);
+}
+
+/**
+ * @brief Comprueba que los dos lados de una partición de [0, n) con el
+ * pivote en pos cumplen menores a la izquierda y mayores o iguales a la
+ * derecha
+ *
+ * @param tabla la tabla particionada
+ * @param n número de elementos
+ * @param pos posición del pivote
+ *
+ * @return 1 si la partición es correcta, 0 en caso contrario
+*/
+static int check_sides(int* tabla, int n, int pos)
+{
+  int i;
+
+  for(i = 0; i < pos; i++) {
+    if (tabla[i] >= tabla[pos]) return 0;
+  }
+  for(i = pos+1; i < n; i++) {
+    if (tabla[i] < tabla[pos]) return 0;
+  }
+  return 1;
+}
+
+/**
+ * @brief Comprueba partition_simd y quicksort_simd con una tabla
+ *
+ * @param orig la tabla de entrada, que no se modifica
+ * @param a tabla de trabajo de n elementos
+ * @param b tabla de trabajo de n elementos
+ * @param n número de elementos
+ *
+ * @return 1 si coinciden con las versiones escalares, 0 en caso contrario
+*/
+static int check(int* orig, int* a, int* b, int n)
+{
+  int pos_a, pos_b, ob_a, ob_b;
+
+  /* particiones: misma posición del pivote, mismas op. básicas y mismos
+     elementos a cada lado, aunque en otro orden */
+  memcpy(a, orig, sizeof(a[0]) * n);
+  memcpy(b, orig, sizeof(b[0]) * n);
+  ob_a = partition_simd(a, 0, n-1, &pos_a);
+  ob_b = partition(b, 0, n-1, &pos_b);
+  if (ob_a == ERR || ob_a != ob_b || pos_a != pos_b) return 0;
+  if (!check_sides(a, n, pos_a) || !check_sides(b, n, pos_b)) return 0;
+  qsort(a, pos_a, sizeof(a[0]), cmp_int);
+  qsort(b, pos_b, sizeof(b[0]), cmp_int);
+  qsort(&a[pos_a+1], n-pos_a-1, sizeof(a[0]), cmp_int);
+  qsort(&b[pos_b+1], n-pos_b-1, sizeof(b[0]), cmp_int);
+  if (memcmp(a, b, sizeof(a[0]) * n) != 0) return 0;
+
+  /* ordenación completa: misma tabla de salida */
+  memcpy(a, orig, sizeof(a[0]) * n);
+  memcpy(b, orig, sizeof(b[0]) * n);
+  if (quicksort_simd(a, 0, n-1) == ERR || quicksort(b, 0, n-1) == ERR) return 0;
+  return memcmp(a, b, sizeof(a[0]) * n) == 0;
+}
+
+/**
+ * @brief Comprueba quickselect y partial_sort con una tabla. Con todas
+ * las claves iguales quickselect debe terminar en una sola partición en
+ * tres, con como mucho 2*n comparaciones
+ *
+ * @param orig la tabla de entrada, que no se modifica
+ * @param a tabla de trabajo de n elementos
+ * @param b tabla de trabajo de n elementos
+ * @param n número de elementos
+ * @param kind tipo de entrada de orig (ver fill)
+ *
+ * @return 1 si los resultados son correctos, 0 en caso contrario
+*/
+static int check_select(int* orig, int* a, int* b, int n, int kind)
+{
+  int i, k, ob;
+
+  /* b es la tabla ordenada de referencia */
+  memcpy(b, orig, sizeof(b[0]) * n);
+  qsort(b, n, sizeof(b[0]), cmp_int);
+
+  k = random_num(0, n-1);
+  memcpy(a, orig, sizeof(a[0]) * n);
+  ob = quickselect(a, 0, n-1, k);
+  if (ob == ERR || a[k] != b[k]) return 0;
+  if (kind == 2 && ob > 2*n) return 0;
+  for(i = 0; i < n; i++) {
+    if ((i < k && a[i] > a[k]) || (i > k && a[i] < a[k])) return 0;
+  }
+
+  k = random_num(0, n);
+  memcpy(a, orig, sizeof(a[0]) * n);
+  if (partial_sort(a, 0, n-1, k) == ERR) return 0;
+  return memcmp(a, b, sizeof(a[0]) * k) == 0;
+}
+
+int main(int argc, char** argv)
+{
+  int i, n, size, n_times, kind, n_tests;
+  int *orig, *a, *b;
+
+  srand(time(NULL));
+
+  if (argc != 5) {
+    fprintf(stderr, "Error in the input parameters:\n\n");
+    fprintf(stderr, "%s -size <int> -n_times <int>\n", argv[0]);
+    fprintf(stderr, "Where:\n");
+    fprintf(stderr, "-size: maximum number of elements of the tables\n");
+    fprintf(stderr, "-n_times: tables tried for each size and kind of input\n");
+    exit(-1);
+  }
+
+  printf("Practice number 3, SIMD partition\n");
+  printf("Done by: Miguel Lozano and Eduardo Junoy\n");
+  printf("Group: 1263\n");
+
+  /* check the command line */
+  size = n_times = 0;
+  for(i = 1; i < argc ; i++) {
+    if (strcmp(argv[i], "-size") == 0) {
+      size = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-n_times") == 0) {
+      n_times = atoi(argv[++i]);
+    } else {
+      fprintf(stderr, "Parameter %s is invalid\n", argv[i]);
+      exit(-1);
+    }
+  }
+  if (size < 1 || n_times < 1) {
+    fprintf(stderr, "-size and -n_times must be positive\n");
+    exit(-1);
+  }
+
+  if (!simd_available()) {
+    printf("AVX2 is not available, the scalar path is checked against itself\n");
+  }
+
+  orig = (int*)malloc(sizeof(orig[0]) * size);
+  a = (int*)malloc(sizeof(a[0]) * size);
+  b = (int*)malloc(sizeof(b[0]) * size);
+  if (orig == NULL || a == NULL || b == NULL) {
+    printf("Error: No hay memoria\n");
+    free(orig);
+    free(a);
+    free(b);
+    exit(-1);
+  }
+
+  /* todos los tamaños pequeños, alrededor de SIMD_CUTOFF, y después
+     tamaños crecientes que no son múltiplos de 8 */
+  n_tests = 0;
+  for(n = 1; n <= size; n = (n < 4*SIMD_CUTOFF) ? n+1 : 2*n+3) {
+    for(kind = 0; kind < N_KINDS; kind++) {
+      for(i = 0; i < n_times; i++, n_tests++) {
+        fill(orig, n, kind);
+        if (!check_select(orig, a, b, n, kind)) {
+          printf("Error: wrong quickselect or partial_sort result (size %d, input %d)\n", n, kind);
+          free(orig);
+          free(a);
+          free(b);
+          exit(-1);
+        }
+        if (!check(orig, a, b, n)) {
+          printf("Error: SIMD and scalar results differ (size %d, input %d)\n", n, kind);
+          free(orig);
+          free(a);
+          free(b);
+          exit(-1);
+        }
+      }
+    }
+  }
+
+  free(orig);
+  free(a);
+  free(b);
+
+  printf("%d tables up to %d elements checked\n", n_tests, size);
+  printf("Correct output \n");
+
+  return 0;
+}
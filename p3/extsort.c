@@ -0,0 +1,309 @@
+/**
+ *
+ * Descripcion: Implementation of the external (out-of-core) merge sort
+ *
+ * Fichero: extsort.c
+ * Autor: Eduardo Junoy y Miguel Lozano
+ * Version: 1.0
+ * Fecha: 17-10-2026
+ *
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "extsort.h"
+
+/* tramo ordenado en disco que se lee por bloques */
+typedef struct {
+  FILE *f;
+  int *buf;       /* bloque leído del tramo */
+  size_t cap;     /* capacidad de buf */
+  size_t n, i;    /* elementos en buf y siguiente a combinar */
+  int fin;        /* 1 cuando se ha agotado el tramo o no se puede leer */
+  int error;      /* 1 si ha fallado la lectura */
+} EXT_RUN;
+
+/**
+ * @brief Lee el siguiente bloque de un tramo. Un error de lectura no se
+ * confunde con el final del tramo: se anota en r->error
+ *
+ * @param r el tramo
+*/
+static void ext_fill(EXT_RUN *r) {
+  r->n = fread(r->buf, sizeof(r->buf[0]), r->cap, r->f);
+  r->i = 0;
+  if(ferror(r->f)) r->error = 1;
+  r->fin = (r->n == 0 || r->error);
+}
+
+/**
+ * @brief Combina k tramos ordenados en out con el árbol de perdedores
+ * de sorting.c, que necesita unas log2(k) comparaciones por elemento. La
+ * cabeza de cada tramo es la siguiente de su bloque. buf se reparte en
+ * k+1 bloques iguales: uno para cada tramo y otro para la salida
+ *
+ * @param in ficheros de los tramos
+ * @param k número de tramos
+ * @param out fichero de salida
+ * @param buf memoria para los bloques
+ * @param n_buf número de enteros de buf
+ * @param n_obs contador de comparaciones de clave
+ *
+ * @return OK o ERR
+*/
+static int ext_merge(FILE **in, int k, FILE *out, int *buf, size_t n_buf, double *n_obs) {
+  EXT_RUN *runs;
+  PLTREE t;
+  int *salida;
+  size_t cap, n_sal;
+  int r, w;
+
+  runs = (EXT_RUN*)malloc(sizeof(runs[0]) * k);
+  t = ltree_create(k);
+  if(runs == NULL || t == NULL) {
+    free(runs);
+    ltree_free(t);
+    return ERR;
+  }
+
+  cap = n_buf / (k+1);
+  for(r = 0; r < k; r++) {
+    rewind(in[r]);
+    runs[r].f = in[r];
+    runs[r].buf = &buf[r*cap];
+    runs[r].cap = cap;
+    runs[r].error = 0;
+    ext_fill(&runs[r]);
+    t->fin[r] = (char)runs[r].fin;
+    t->cab[r] = runs[r].fin ? INT_MAX : runs[r].buf[0];
+  }
+  salida = &buf[k*cap];
+  ltree_build(t);
+
+  n_sal = 0;
+  while(!t->fin[LTREE_WINNER(t)]) {
+    w = LTREE_WINNER(t);
+    salida[n_sal++] = t->cab[w];
+    if(n_sal == cap) {
+      if(fwrite(salida, sizeof(salida[0]), n_sal, out) != n_sal) break;
+      n_sal = 0;
+    }
+    if(++runs[w].i == runs[w].n) ext_fill(&runs[w]);
+    t->fin[w] = (char)runs[w].fin;
+    t->cab[w] = runs[w].fin ? INT_MAX : runs[w].buf[runs[w].i];
+    ltree_replace(t, w);
+  }
+
+  /* Si se ha salido por un error de escritura quedan tramos sin agotar */
+  w = !t->fin[LTREE_WINNER(t)];
+  if(fwrite(salida, sizeof(salida[0]), n_sal, out) != n_sal) w = 1;
+  for(r = 0; r < k; r++) {
+    if(runs[r].error) w = 1;
+  }
+
+  *n_obs += t->n_obs;
+  free(runs);
+  ltree_free(t);
+  return w ? ERR : OK;
+}
+
+/**
+ * @brief Cierra (y con ello borra) los ficheros temporales de los tramos
+ *
+ * @param runs los ficheros
+ * @param n_runs número de ficheros
+*/
+static void ext_close(FILE **runs, int n_runs) {
+  int i;
+
+  for(i = 0; i < n_runs; i++) {
+    if(runs[i] != NULL) fclose(runs[i]);
+  }
+}
+
+/**
+ * @brief Devuelve el tiempo de reloj actual en segundos
+ *
+ * @return el tiempo en segundos
+*/
+static double ext_now(void) {
+  struct timespec t;
+
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec/1e9;
+}
+
+/**
+ * @brief Implementación común de extsort y extsort_buf. Lee la entrada en
+ * trozos, ordena cada trozo y lo vuelca a un fichero temporal; después
+ * combina los tramos con un árbol de perdedores en pasadas de como mucho
+ * EXT_FANIN tramos, leyendo y escribiendo por bloques grandes con toda la
+ * memoria. Si la entrada cabe en un trozo se escribe directamente en la
+ * salida. Se usa exactamente uno de method y method_buf: con method_buf
+ * los trozos son de mem/2 bytes y la otra mitad es su tabla auxiliar
+ *
+ * @param in_file fichero de entrada
+ * @param out_file fichero de salida
+ * @param mem memoria a usar en bytes, al menos EXT_MIN_MEM
+ * @param method función de ordenación de los trozos o NULL
+ * @param method_buf función de ordenación con tabla auxiliar o NULL
+ * @param stats si no es NULL, devuelve las estadísticas de la ordenación
+ *
+ * @return OK o ERR
+*/
+static int ext_sort(char* in_file, char* out_file, size_t mem, pfunc_sort method, pfunc_sort_buf method_buf, PEXT_STATS stats) {
+  FILE *fin, *fout, *f;
+  FILE **runs, **aux;
+  int *buf;
+  size_t n_buf, n_trozo, n;
+  int n_runs, n_tramos, cap_runs, n_nuevos, g, k, st, n_passes;
+  long n_elems;
+  double n_obs, t0;
+
+  if(in_file == NULL || out_file == NULL || mem < EXT_MIN_MEM) return ERR;
+
+  /* Los índices de los métodos de ordenación son int */
+  n_buf = mem / sizeof(buf[0]);
+  n_trozo = (method_buf != NULL) ? n_buf/2 : n_buf;
+  if(n_trozo > INT_MAX) return ERR;
+
+  t0 = ext_now();
+  buf = (int*)malloc(sizeof(buf[0]) * n_buf);
+  if(buf == NULL) return ERR;
+
+  fin = fopen(in_file, "rb");
+  fout = fopen(out_file, "wb");
+  if(fin == NULL || fout == NULL) {
+    if(fin != NULL) fclose(fin);
+    if(fout != NULL) fclose(fout);
+    free(buf);
+    return ERR;
+  }
+
+  /* Formación de tramos */
+  runs = NULL;
+  n_runs = cap_runs = 0;
+  n_elems = 0;
+  n_obs = 0;
+  st = OK;
+  while(st == OK && (n = fread(buf, sizeof(buf[0]), n_trozo, fin)) > 0) {
+    n_elems += n;
+    if(method_buf != NULL) st = method_buf(buf, 0, (int)n-1, &buf[n_trozo]);
+    else st = method(buf, 0, (int)n-1);
+    if(st == ERR) break;
+    n_obs += st;
+    st = OK;
+
+    if(n_runs == 0 && n < n_trozo) {
+      /* La entrada cabe entera en memoria */
+      if(fwrite(buf, sizeof(buf[0]), n, fout) != n) st = ERR;
+      break;
+    }
+
+    if(n_runs == cap_runs) {
+      cap_runs = cap_runs ? 2*cap_runs : EXT_FANIN;
+      aux = (FILE**)realloc(runs, sizeof(runs[0]) * cap_runs);
+      if(aux == NULL) {
+        st = ERR;
+        break;
+      }
+      runs = aux;
+    }
+    f = tmpfile();
+    if(f == NULL) {
+      st = ERR;
+      break;
+    }
+    runs[n_runs++] = f;
+    if(fwrite(buf, sizeof(buf[0]), n, f) != n) st = ERR;
+  }
+  if(ferror(fin)) st = ERR;
+  fclose(fin);
+
+  /* Pasadas intermedias: cada grupo de EXT_FANIN tramos pasa a ser uno */
+  n_tramos = n_runs;
+  n_passes = 0;
+  while(st == OK && n_runs > EXT_FANIN) {
+    n_passes++;
+    n_nuevos = 0;
+    for(g = 0; g < n_runs; g += k) {
+      k = (n_runs-g < EXT_FANIN) ? n_runs-g : EXT_FANIN;
+      f = tmpfile();
+      st = (f == NULL) ? ERR : ext_merge(&runs[g], k, f, buf, n_buf, &n_obs);
+      ext_close(&runs[g], k);
+      /* n_nuevos <= g, así que no se pisa ningún tramo pendiente */
+      runs[n_nuevos++] = f;
+      if(st == ERR) {
+        ext_close(&runs[g+k], n_runs-g-k);
+        break;
+      }
+    }
+    n_runs = n_nuevos;
+  }
+
+  /* Última pasada, directamente sobre la salida */
+  if(st == OK && n_runs > 0) {
+    n_passes++;
+    st = ext_merge(runs, n_runs, fout, buf, n_buf, &n_obs);
+  }
+  ext_close(runs, n_runs);
+  if(fclose(fout) != 0) st = ERR;
+
+  if(stats != NULL) {
+    stats->n_elems = n_elems;
+    stats->n_runs = n_tramos;
+    stats->n_passes = n_passes;
+    stats->n_obs = n_obs;
+    stats->time = ext_now() - t0;
+    stats->mb_s = (stats->time > 0) ? n_elems*sizeof(buf[0]) / (1024.0*1024.0) / stats->time : 0;
+  }
+
+  free(runs);
+  free(buf);
+  return st;
+}
+
+/**
+ * @brief Ordena de menor a mayor un fichero binario de enteros que no
+ * tiene por qué caber en memoria, ordenando trozos de mem bytes con
+ * method (ver ext_sort). La memoria que reserve method por su cuenta
+ * (mergesort, timsort, radixsort...) no está incluida en mem; para esos
+ * métodos es mejor extsort_buf
+ *
+ * @param in_file fichero de entrada
+ * @param out_file fichero de salida
+ * @param mem memoria a usar en bytes, al menos EXT_MIN_MEM
+ * @param method función de ordenación de los trozos
+ * @param stats si no es NULL, devuelve las estadísticas de la ordenación
+ *
+ * @return OK o ERR
+*/
+int extsort(char* in_file, char* out_file, size_t mem, pfunc_sort method, PEXT_STATS stats) {
+  if(method == NULL) return ERR;
+
+  return ext_sort(in_file, out_file, mem, method, NULL, stats);
+}
+
+/**
+ * @brief Ordena de menor a mayor un fichero binario de enteros como
+ * extsort, pero con un método que recibe su tabla auxiliar (como
+ * mergesort_buf). Los trozos son de mem/2 bytes y la otra mitad es la
+ * tabla auxiliar, así que no se usa más memoria que mem
+ *
+ * @param in_file fichero de entrada
+ * @param out_file fichero de salida
+ * @param mem memoria a usar en bytes, al menos EXT_MIN_MEM
+ * @param method función de ordenación de los trozos con tabla auxiliar
+ * @param stats si no es NULL, devuelve las estadísticas de la ordenación
+ *
+ * @return OK o ERR
+*/
+int extsort_buf(char* in_file, char* out_file, size_t mem, pfunc_sort_buf method, PEXT_STATS stats) {
+  if(method == NULL) return ERR;
+
+  return ext_sort(in_file, out_file, mem, NULL, method, stats);
+}
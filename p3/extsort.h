@@ -0,0 +1,52 @@
+/**
+ *
+ * Descripcion: Header file for the external (out-of-core) merge sort
+ *
+ * Fichero: extsort.h
+ * Autor: Eduardo Junoy y Miguel Lozano
+ * Version: 1.0
+ * Fecha: 17-10-2026
+ *
+ */
+
+#ifndef EXTSORT_H
+#define EXTSORT_H
+
+#include <stddef.h>
+#include "sorting.h"
+
+/* constants */
+
+#ifndef ERR
+  #define ERR -1
+  #define OK (!(ERR))
+#endif
+
+/* número máximo de tramos que se combinan a la vez; si hay más se
+   combinan por grupos en varias pasadas */
+#define EXT_FANIN 64
+
+/* memoria mínima de extsort, en bytes */
+#define EXT_MIN_MEM (64*1024)
+
+/* type definitions */
+typedef struct ext_stats {
+  long n_elems;    /* number of sorted ints */
+  int n_runs;      /* sorted runs spilled to disk */
+  int n_passes;    /* merge passes over the data */
+  double n_obs;    /* key comparisons (sort of the runs plus merges) */
+  double time;     /* wall clock time in seconds */
+  double mb_s;     /* input megabytes sorted per second */
+} EXT_STATS, *PEXT_STATS;
+
+/* Functions */
+
+/* mem acota la memoria de extsort salvo la que reserve method por su 
+   cuenta, que con una tabla auxiliar puede llegar a otros mem bytes. 
+   extsort_buf da a method la mitad de mem como tabla auxiliar y no usa 
+   más de mem. Los dos devuelven ERR si un trozo tendría más de INT_MAX 
+   enteros */
+int extsort(char* in_file, char* out_file, size_t mem, pfunc_sort method, PEXT_STATS stats);
+int extsort_buf(char* in_file, char* out_file, size_t mem, pfunc_sort_buf method, PEXT_STATS stats);
+
+#endif
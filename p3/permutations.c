@@ -14,6 +14,14 @@
 #include <stdlib.h>
 #include <assert.h>
 
+/* número de intercambios realizados por swap desde el último reset_swap_count. 
+   Cada hilo tiene el suyo para que los ordenamientos paralelos no compitan por él */
+#ifdef __GNUC__
+static __thread long n_swaps = 0;
+#else
+static long n_swaps = 0;
+#endif
+
 /**
  * @brief Intercambia dos elementos
  * 
@@ -24,6 +32,34 @@ void swap(int *a, int *b) {
   int aux = *a;
   *a = *b;
   *b = aux;
+  n_swaps++;
+}
+
+/**
+ * @brief Pone a cero el contador de intercambios de swap
+*/
+void reset_swap_count(void) {
+  n_swaps = 0;
+}
+
+/**
+ * @brief Devuelve el número de intercambios realizados por swap desde la 
+ * última llamada a reset_swap_count
+ * 
+ * @return el número de intercambios
+*/
+long swap_count(void) {
+  return n_swaps;
+}
+
+/**
+ * @brief Suma al contador de intercambios del hilo actual los realizados 
+ * por otros hilos en su nombre
+ * 
+ * @param n número de intercambios a sumar
+*/
+void add_swap_count(long n) {
+  n_swaps += n;
 }
 
 /**
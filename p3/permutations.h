@@ -23,4 +23,7 @@ int random_num(int inf, int sup);
 int* generate_perm(int N);
 int** generate_permutations(int n_perms, int N);
 void swap(int *a, int *b);
+void reset_swap_count(void);
+long swap_count(void);
+void add_swap_count(long n);
 #endif
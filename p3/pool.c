@@ -0,0 +1,430 @@
+/**
+ *
+ * Descripcion: Implementation of the thread pool used by the parallel sorts
+ *
+ * Fichero: pool.c
+ * Autor: Eduardo Junoy y Miguel Lozano
+ * Version: 1.0
+ * Fecha: 17-10-2026
+ *
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "pool.h"
+
+struct pool {
+  int n_threads;          /* hilos que ejecutan tareas, incluido el llamante */
+  int fin;                /* 1 cuando los hilos deben terminar */
+  PTASK cola;             /* tareas pendientes, la última enviada primero */
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;    /* se señala al enviar o terminar una tarea */
+  pthread_t *hilos;
+};
+
+/**
+ * @brief Ejecuta una tarea y la marca como terminada. Se llama sin 
+ * tener el mutex y lo devuelve tomado
+ * 
+ * @param pool el pool
+ * @param task la tarea a ejecutar
+*/
+static void pool_run(PPOOL pool, PTASK task) {
+  task->func(task->arg);
+
+  pthread_mutex_lock(&pool->mutex);
+  task->done = 1;
+  pthread_cond_broadcast(&pool->cond);
+}
+
+/**
+ * @brief Bucle de los hilos trabajadores: ejecutan tareas de la cola 
+ * hasta que se libera el pool
+ * 
+ * @param arg el pool
+ * 
+ * @return NULL
+*/
+static void* pool_worker(void *arg) {
+  PPOOL pool = (PPOOL)arg;
+  PTASK task;
+
+  pthread_mutex_lock(&pool->mutex);
+  while(!pool->fin) {
+    if(pool->cola == NULL) {
+      pthread_cond_wait(&pool->cond, &pool->mutex);
+      continue;
+    }
+    task = pool->cola;
+    pool->cola = task->next;
+    pthread_mutex_unlock(&pool->mutex);
+    pool_run(pool, task);
+  }
+  pthread_mutex_unlock(&pool->mutex);
+
+  return NULL;
+}
+
+/**
+ * @brief Devuelve el número de procesadores disponibles
+ * 
+ * @return el número de procesadores, como mínimo 1
+*/
+int pool_default_threads(void) {
+  long n;
+
+  n = sysconf(_SC_NPROCESSORS_ONLN);
+  if(n < 1) return 1;
+
+  return (int)n;
+}
+
+/**
+ * @brief Crea un pool de hilos. El hilo que llama a pool_wait también 
+ * ejecuta tareas, por lo que se crean n_threads-1 hilos trabajadores
+ * 
+ * @param n_threads número total de hilos
+ * 
+ * @return el pool creado o NULL en caso de error
+*/
+PPOOL pool_create(int n_threads) {
+  PPOOL pool;
+  int i;
+
+  if(n_threads < 1) return NULL;
+
+  pool = (PPOOL)malloc(sizeof(pool[0]));
+  if(pool == NULL) return NULL;
+
+  pool->hilos = (pthread_t*)malloc(sizeof(pool->hilos[0]) * n_threads);
+  if(pool->hilos == NULL) {
+    free(pool);
+    return NULL;
+  }
+
+  pool->n_threads = 1;
+  pool->fin = 0;
+  pool->cola = NULL;
+  pthread_mutex_init(&pool->mutex, NULL);
+  pthread_cond_init(&pool->cond, NULL);
+
+  for(i = 1; i < n_threads; i++) {
+    if(pthread_create(&pool->hilos[i], NULL, pool_worker, pool) != 0) {
+      pool_free(pool);
+      return NULL;
+    }
+    pool->n_threads++;
+  }
+
+  return pool;
+}
+
+/**
+ * @brief Termina los hilos trabajadores y libera el pool. No debe quedar 
+ * ninguna tarea pendiente
+ * 
+ * @param pool el pool a liberar
+*/
+void pool_free(PPOOL pool) {
+  int i;
+
+  if(pool == NULL) return;
+
+  pthread_mutex_lock(&pool->mutex);
+  pool->fin = 1;
+  pthread_cond_broadcast(&pool->cond);
+  pthread_mutex_unlock(&pool->mutex);
+
+  for(i = 1; i < pool->n_threads; i++) {
+    pthread_join(pool->hilos[i], NULL);
+  }
+
+  pthread_mutex_destroy(&pool->mutex);
+  pthread_cond_destroy(&pool->cond);
+  free(pool->hilos);
+  free(pool);
+}
+
+/**
+ * @brief Devuelve el número total de hilos del pool
+ * 
+ * @param pool el pool
+ * 
+ * @return el número de hilos
+*/
+int pool_n_threads(PPOOL pool) {
+  return pool->n_threads;
+}
+
+/**
+ * @brief Encola una tarea. La memoria de task la gestiona el llamante y 
+ * debe seguir siendo válida hasta que pool_wait termine
+ * 
+ * @param pool el pool
+ * @param task la tarea
+ * @param func función a ejecutar
+ * @param arg argumento de func
+*/
+void pool_submit(PPOOL pool, PTASK task, pfunc_task func, void *arg) {
+  task->func = func;
+  task->arg = arg;
+  task->done = 0;
+
+  pthread_mutex_lock(&pool->mutex);
+  task->next = pool->cola;
+  pool->cola = task;
+  pthread_cond_signal(&pool->cond);
+  pthread_mutex_unlock(&pool->mutex);
+}
+
+/**
+ * @brief Espera a que termine una tarea. Mientras espera, el hilo 
+ * ejecuta otras tareas de la cola para no quedarse parado
+ * 
+ * @param pool el pool
+ * @param task la tarea a esperar
+*/
+void pool_wait(PPOOL pool, PTASK task) {
+  PTASK otra;
+
+  pthread_mutex_lock(&pool->mutex);
+  while(!task->done) {
+    if(pool->cola == NULL) {
+      pthread_cond_wait(&pool->cond, &pool->mutex);
+      continue;
+    }
+    otra = pool->cola;
+    pool->cola = otra->next;
+    pthread_mutex_unlock(&pool->mutex);
+    pool_run(pool, otra);
+  }
+  pthread_mutex_unlock(&pool->mutex);
+}
+
+/* tramo pendiente del planificador con robo de trabajo */
+typedef struct {
+  int ip, iu;
+} WS_RANGE;
+
+/* cola doble de un hilo: el dueño saca por abajo y los demás roban por arriba */
+typedef struct {
+  pthread_mutex_t mutex;
+  WS_RANGE *items;
+  int arriba, abajo;   /* tramos en [arriba, abajo) */
+  int cap;
+} WS_DEQUE;
+
+struct ws {
+  int n_threads;
+  WS_DEQUE *deques;
+  pfunc_ws_task func;
+  void *arg;
+  int disponibles;        /* tramos en las colas */
+  int pendientes;         /* tramos en las colas o en ejecución */
+  int error;
+  pthread_mutex_t mutex;  /* protege disponibles, pendientes y error */
+  pthread_cond_t cond;
+};
+
+/* argumentos de los hilos de ws_run */
+typedef struct {
+  PWS ws;
+  int id;
+} WS_ARGS;
+
+/**
+ * @brief Saca un tramo de la cola del hilo id, por abajo si es la suya 
+ * y por arriba si la roba
+ * 
+ * @param ws el planificador
+ * @param id cola de la que se saca
+ * @param robar 1 si se roba, 0 si es la cola propia
+ * @param r tramo sacado
+ * 
+ * @return 1 si se ha sacado un tramo, 0 si la cola estaba vacía
+*/
+static int ws_take(PWS ws, int id, int robar, WS_RANGE *r) {
+  WS_DEQUE *d = &ws->deques[id];
+  int ok = 0;
+
+  pthread_mutex_lock(&d->mutex);
+  if(d->arriba < d->abajo) {
+    if(robar) *r = d->items[d->arriba++];
+    else *r = d->items[--d->abajo];
+    ok = 1;
+  }
+  pthread_mutex_unlock(&d->mutex);
+
+  if(ok) {
+    pthread_mutex_lock(&ws->mutex);
+    ws->disponibles--;
+    pthread_mutex_unlock(&ws->mutex);
+  }
+
+  return ok;
+}
+
+/**
+ * @brief Bucle de cada hilo de ws_run: ejecuta los tramos de su cola, 
+ * roba de las demás cuando se vacía y termina cuando no queda ninguno
+ * 
+ * @param arg puntero a WS_ARGS
+ * 
+ * @return NULL
+*/
+static void* ws_worker(void *arg) {
+  WS_ARGS *a = (WS_ARGS*)arg;
+  PWS ws = a->ws;
+  WS_RANGE r;
+  int i, hay;
+
+  while(1) {
+    hay = ws_take(ws, a->id, 0, &r);
+    for(i = 1; !hay && i < ws->n_threads; i++) {
+      hay = ws_take(ws, (a->id+i) % ws->n_threads, 1, &r);
+    }
+
+    if(hay) {
+      ws->func(ws, a->id, r.ip, r.iu, ws->arg);
+      pthread_mutex_lock(&ws->mutex);
+      if(--ws->pendientes == 0) pthread_cond_broadcast(&ws->cond);
+      pthread_mutex_unlock(&ws->mutex);
+      continue;
+    }
+
+    pthread_mutex_lock(&ws->mutex);
+    while(ws->disponibles == 0 && ws->pendientes > 0) {
+      pthread_cond_wait(&ws->cond, &ws->mutex);
+    }
+    if(ws->pendientes == 0) {
+      pthread_mutex_unlock(&ws->mutex);
+      return NULL;
+    }
+    pthread_mutex_unlock(&ws->mutex);
+  }
+}
+
+/**
+ * @brief Añade un tramo a la cola del hilo id para que lo ejecute él o 
+ * lo robe otro hilo
+ * 
+ * @param ws el planificador
+ * @param id hilo que añade el tramo
+ * @param ip primer elemento del tramo
+ * @param iu último elemento del tramo
+ * 
+ * @return OK o ERR si no hay memoria
+*/
+int ws_push(PWS ws, int id, int ip, int iu) {
+  WS_DEQUE *d = &ws->deques[id];
+  WS_RANGE *items;
+  int n;
+
+  pthread_mutex_lock(&d->mutex);
+  if(d->abajo == d->cap) {
+    /* Se compacta la cola y se duplica si sigue llena */
+    n = d->abajo - d->arriba;
+    memmove(d->items, &d->items[d->arriba], sizeof(d->items[0]) * n);
+    d->arriba = 0;
+    d->abajo = n;
+    if(n == d->cap) {
+      items = (WS_RANGE*)realloc(d->items, sizeof(d->items[0]) * d->cap * 2);
+      if(items == NULL) {
+        pthread_mutex_unlock(&d->mutex);
+        pthread_mutex_lock(&ws->mutex);
+        ws->error = 1;
+        pthread_mutex_unlock(&ws->mutex);
+        return ERR;
+      }
+      d->items = items;
+      d->cap *= 2;
+    }
+  }
+  d->items[d->abajo].ip = ip;
+  d->items[d->abajo].iu = iu;
+  d->abajo++;
+  pthread_mutex_unlock(&d->mutex);
+
+  pthread_mutex_lock(&ws->mutex);
+  ws->disponibles++;
+  ws->pendientes++;
+  pthread_cond_signal(&ws->cond);
+  pthread_mutex_unlock(&ws->mutex);
+
+  return OK;
+}
+
+/**
+ * @brief Ejecuta func sobre el tramo [ip, iu] con n_threads hilos que 
+ * se reparten por robo de trabajo los tramos que func añade con ws_push. 
+ * func recibe el planificador, el número de hilo (de 0 a n_threads-1), 
+ * el tramo y arg
+ * 
+ * @param n_threads número de hilos
+ * @param func función que procesa cada tramo
+ * @param arg argumento de func
+ * @param ip primer elemento del tramo inicial
+ * @param iu último elemento del tramo inicial
+ * 
+ * @return OK cuando se han procesado todos los tramos o ERR en caso de error
+*/
+int ws_run(int n_threads, pfunc_ws_task func, void *arg, int ip, int iu) {
+  WS ws;
+  WS_ARGS *args;
+  pthread_t *hilos;
+  int i, creados, st;
+
+  if(n_threads < 1 || func == NULL) return ERR;
+
+  ws.n_threads = n_threads;
+  ws.func = func;
+  ws.arg = arg;
+  ws.disponibles = ws.pendientes = ws.error = 0;
+  ws.deques = (WS_DEQUE*)calloc(n_threads, sizeof(ws.deques[0]));
+  args = (WS_ARGS*)malloc(sizeof(args[0]) * n_threads);
+  hilos = (pthread_t*)malloc(sizeof(hilos[0]) * n_threads);
+  if(ws.deques == NULL || args == NULL || hilos == NULL) {
+    free(ws.deques);
+    free(args);
+    free(hilos);
+    return ERR;
+  }
+
+  pthread_mutex_init(&ws.mutex, NULL);
+  pthread_cond_init(&ws.cond, NULL);
+  for(i = 0; i < n_threads; i++) {
+    pthread_mutex_init(&ws.deques[i].mutex, NULL);
+    ws.deques[i].cap = WS_DEQUE_SIZE;
+    ws.deques[i].items = (WS_RANGE*)malloc(sizeof(WS_RANGE) * WS_DEQUE_SIZE);
+    if(ws.deques[i].items == NULL) ws.error = 1;
+    args[i].ws = &ws;
+    args[i].id = i;
+  }
+
+  if(!ws.error) ws_push(&ws, 0, ip, iu);
+
+  /* El hilo llamante hace de hilo 0 */
+  for(creados = 1; !ws.error && creados < n_threads; creados++) {
+    if(pthread_create(&hilos[creados], NULL, ws_worker, &args[creados]) != 0) break;
+  }
+  if(!ws.error) ws_worker(&args[0]);
+  for(i = 1; i < creados; i++) {
+    pthread_join(hilos[i], NULL);
+  }
+
+  st = ws.error ? ERR : OK;
+
+  for(i = 0; i < n_threads; i++) {
+    pthread_mutex_destroy(&ws.deques[i].mutex);
+    free(ws.deques[i].items);
+  }
+  pthread_mutex_destroy(&ws.mutex);
+  pthread_cond_destroy(&ws.cond);
+  free(ws.deques);
+  free(args);
+  free(hilos);
+  return st;
+}
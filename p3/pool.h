@@ -0,0 +1,52 @@
+/**
+ *
+ * Descripcion: Header file for the thread pool used by the parallel sorts
+ *
+ * Fichero: pool.h
+ * Autor: Eduardo Junoy y Miguel Lozano
+ * Version: 1.0
+ * Fecha: 17-10-2026
+ *
+ */
+
+#ifndef POOL_H
+#define POOL_H
+
+/* constants */
+
+#ifndef ERR
+  #define ERR -1
+  #define OK (!(ERR))
+#endif
+
+/* capacidad inicial de cada cola de ws_run */
+#define WS_DEQUE_SIZE 64
+
+/* type definitions */
+typedef void (* pfunc_task)(void*);
+
+typedef struct task {
+  pfunc_task func;    /* function to run */
+  void *arg;          /* argument of func */
+  int done;           /* 1 once func has returned */
+  struct task *next;  /* next task in the pool queue */
+} TASK, *PTASK;
+
+typedef struct pool POOL, *PPOOL;
+
+typedef struct ws WS, *PWS;
+typedef void (* pfunc_ws_task)(PWS, int, int, int, void*);
+
+/* Functions */
+
+int pool_default_threads(void);
+PPOOL pool_create(int n_threads);
+void pool_free(PPOOL pool);
+int pool_n_threads(PPOOL pool);
+void pool_submit(PPOOL pool, PTASK task, pfunc_task func, void *arg);
+void pool_wait(PPOOL pool, PTASK task);
+
+int ws_run(int n_threads, pfunc_ws_task func, void *arg, int ip, int iu);
+int ws_push(PWS ws, int id, int ip, int iu);
+
+#endif
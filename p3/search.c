@@ -11,12 +11,19 @@
 
 
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include <assert.h>
 #include <stdio.h>
 #include "search.h"
 #include "times.h"
 
+#ifdef __GNUC__
+  #define PREFETCH(p) __builtin_prefetch(p)
+#else
+  #define PREFETCH(p)
+#endif
+
 /**
  *  Key generation functions
  *
@@ -63,7 +70,8 @@ void potential_key_generator(int *keys, int n_keys, int max)
  * @brief Inicializa un diccionario
  * 
  * @param size el tamaño del diccionario
- * @param order el diccionario está ordenado o no
+ * @param order NOT_SORTED, SORTED o EYTZINGER (ordenado y guardado en 
+ * orden de anchura para eytz_search)
  * 
  * @returns Un diccionario inicializado
 */
@@ -71,7 +79,7 @@ PDICT init_dictionary (int size, char order)
 {
   PDICT dic_new;
 
-  assert(size >= 0 && (order == SORTED || order == NOT_SORTED));
+  assert(size >= 0 && (order == SORTED || order == NOT_SORTED || order == EYTZINGER));
 
   dic_new = (PDICT)malloc(sizeof(DICT));
   if(dic_new == NULL) return NULL;
@@ -116,6 +124,8 @@ int insert_dictionary(PDICT pdict, int key)
   int j, nobs = 0, aux, i;
 
   assert(pdict != NULL);
+
+  if (pdict->order == EYTZINGER) return massive_insertion_dictionary(pdict, &key, 1);
   
   pdict->n_data++;
   pdict->table[pdict->n_data-1] = key;
@@ -148,6 +158,17 @@ int massive_insertion_dictionary (PDICT pdict,int *keys, int n_keys)
 
   assert(pdict != NULL && keys != NULL);
 
+  if (pdict->order == EYTZINGER) {
+    /* Se inserta en orden y se vuelve a colocar en orden de anchura al final */
+    if(eytzinger_layout(pdict->table, pdict->n_data, 0) == ERR) return ERR;
+    pdict->order = SORTED;
+    obs = massive_insertion_dictionary(pdict, keys, n_keys);
+    if(obs == ERR) return ERR;
+    if(eytzinger_layout(pdict->table, pdict->n_data, 1) == ERR) return ERR;
+    pdict->order = EYTZINGER;
+    return obs;
+  }
+
   for(i=0; i<n_keys; i++) {
     st = insert_dictionary(pdict, keys[i]);
     if(st==ERR) return ERR;
@@ -157,6 +178,66 @@ int massive_insertion_dictionary (PDICT pdict,int *keys, int n_keys)
   return obs;
 }
 
+/**
+ * @brief Recorre en orden el árbol implícito de t (hijos de k en 2k+1 y 
+ * 2k+2) copiando entre t y la tabla ordenada s
+ * 
+ * @param s la tabla ordenada
+ * @param t la tabla en orden de anchura
+ * @param i siguiente posición de s
+ * @param k nodo actual
+ * @param n número de elementos
+ * @param to_eytz 1 para copiar de s a t, 0 para copiar de t a s
+ * 
+ * @returns la siguiente posición de s tras el subárbol de k
+*/
+static int eytzinger_copy(int *s, int *t, int i, int k, int n, int to_eytz)
+{
+  if(k >= n) return i;
+
+  i = eytzinger_copy(s, t, i, 2*k+1, n, to_eytz);
+  if(to_eytz) t[k] = s[i];
+  else s[i] = t[k];
+  i++;
+
+  return eytzinger_copy(s, t, i, 2*k+2, n, to_eytz);
+}
+
+/**
+ * @brief Reordena una tabla entre el orden creciente y el orden de 
+ * Eytzinger (el de un recorrido en anchura del árbol binario de búsqueda 
+ * equilibrado), en el que los primeros niveles de la búsqueda quedan 
+ * juntos al principio de la tabla
+ * 
+ * @param table la tabla
+ * @param n número de elementos
+ * @param to_eytz 1 para pasar de orden creciente a Eytzinger, 0 al revés
+ * 
+ * @returns OK o ERR
+*/
+int eytzinger_layout(int *table, int n, int to_eytz)
+{
+  int *aux;
+
+  assert(table != NULL && n >= 0);
+
+  if(n < 2) return OK;
+
+  aux = (int*)malloc(sizeof(aux[0]) * n);
+  if(aux == NULL) return ERR;
+
+  if(to_eytz) {
+    eytzinger_copy(table, aux, 0, 0, n, 1);
+  }
+  else {
+    eytzinger_copy(aux, table, 0, 0, n, 0);
+  }
+  memcpy(table, aux, sizeof(aux[0]) * n);
+
+  free(aux);
+  return OK;
+}
+
 /**
  * @brief Busca un elemento en el diccionario
  * 
@@ -213,6 +294,56 @@ int bin_search(int *table,int F,int L,int key, int *ppos)
   return NOT_FOUND;
 }
 
+/**
+ * @brief Busca un elemento en una tabla en orden de Eytzinger (diccionario 
+ * EYTZINGER). Baja por el árbol sin saltos condicionales, eligiendo el 
+ * hijo 2k+1 o 2k+2 con el resultado de la comparación, y mientras tanto 
+ * pide a la caché el bloque de 16 nodos que se visitará cuatro niveles
+ * más abajo (t[16k+15..16k+30]). La tabla no está alineada a 64 bytes,
+ * así que el bloque puede ocupar dos líneas y se piden sus dos extremos.
+ * Al salir del árbol, los bits de k indican el último nodo 
+ * donde se bajó a la izquierda, que es el primero no menor que key
+ * 
+ * @param table tabla del diccionario en el que se busca el elemento
+ * @param F el primer elemento de la tabla
+ * @param L el último elemento de la tabla
+ * @param key elemento que se busca
+ * @param ppos puntero a la posición dentro del diccionario
+ * 
+ * @returns El número de OBs realizadas
+*/
+int eytz_search(int *table,int F,int L,int key, int *ppos)
+{
+  int *t;
+  int n, k, obs = 0;
+
+  assert(table != NULL);
+
+  t = &table[F];
+  n = L-F+1;
+  k = 0;
+  while(k < n) {
+    if(16*k+15 < n) {
+      PREFETCH(&t[16*k+15]);
+      PREFETCH(&t[16*k+30 < n ? 16*k+30 : n-1]);
+    }
+    obs++;
+    k = 2*k+1 + (t[k] < key);
+  }
+
+  /* Con numeración desde 1 (k+1) se quitan los pasos a la derecha del 
+     final y el último a la izquierda */
+  for(k = k+1; k & 1; k >>= 1);
+  k >>= 1;
+  if(k == 0) return NOT_FOUND;
+
+  obs++;
+  if(t[k-1] != key) return NOT_FOUND;
+
+  *ppos = F+k-1;
+  return obs;
+}
+
 /**
  * @brief Busca un elemento en el diccionario con búsqueda lineal
  * 
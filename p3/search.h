@@ -24,12 +24,13 @@
 
 #define SORTED 1
 #define NOT_SORTED 0
+#define EYTZINGER 2
 
 /* type definitions */
 typedef struct dictionary {
   int size; /* table size */
   int n_data; /* number of entries in the table */
-  char order;  /* sorted or unsorted table */
+  char order;  /* unsorted, sorted or Eytzinger (sorted, BFS order) table */
   int *table;  /* data table */
 } DICT, *PDICT;
 
@@ -42,12 +43,14 @@ void free_dictionary(PDICT pdict);
 int insert_dictionary(PDICT pdict, int key);
 int massive_insertion_dictionary (PDICT pdict,int *keys, int n_keys);
 int search_dictionary(PDICT pdict, int key, int *ppos, pfunc_search method);
+int eytzinger_layout(int *table, int n, int to_eytz);
 
 
 /* Search functions for the Dictionary ADT */
 int bin_search(int *table,int F,int L,int key, int *ppos);
 int lin_search(int *table,int F,int L,int key, int *ppos);
 int lin_auto_search(int *table,int F,int L,int key, int *ppos);
+int eytz_search(int *table,int F,int L,int key, int *ppos);
 
 /**
  *  Key generation functions
@@ -8,211 +8,3141 @@
  * Fecha: 16-09-2019
  *
  */
+#define _POSIX_C_SOURCE 200112L
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <limits.h>
 #include <assert.h>
+#include <pthread.h>
 #include "sorting.h"
 #include "permutations.h"
+#include "pool.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #define SORTING_AVX2
+  #include <immintrin.h>
+#endif
+
+static int partition3_at(int* tabla, int ip, int iu, int pos, int *lt, int *gt);
+static int select_rec(int* tabla, int ip, int iu, int k, int mom);
+
+#ifdef __GNUC__
+  #define PREFETCH(p) __builtin_prefetch(p)
+#else
+  #define PREFETCH(p)
+#endif
+
+/**
+ * @brief Ordena de mayor a menor un array
+ * 
+ * @param array el array a ordenar
+ * @param ip primer índice del array
+ * @param iu último índice del array
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int SelectSortInv(int* array, int ip, int iu)
+{
+  int i, count, minimum;
+
+  if(array == NULL || ip > iu) return ERR;
+
+  for(i=0; i<iu; i++);
+
+  count = 0;
+  while(i >= 0) {
+    minimum = min(array, ip, i);
+    count += i-ip;
+    swap(&array[i], &array[minimum]);
+    i--;
+  }
+
+  return count;
+}
+
+#ifdef SORTING_AVX2
+
+/**
+ * @brief Elige entre los mínimos de cada carril el menor, y entre 
+ * iguales el de menor índice, y lo compara con los elementos finales
+ * 
+ * @param array el array en el que busca
+ * @param vals mínimo de cada carril
+ * @param idx primer índice del mínimo de cada carril
+ * @param n_lanes número de carriles
+ * @param i primer elemento no recorrido por los carriles
+ * @param iu último índice del array
+ * 
+ * @return el índice del primer menor elemento del array
+*/
+static int min_reduce(int* array, int* vals, int* idx, int n_lanes, int i, int iu)
+{
+  int l, min;
+
+  min = idx[0];
+  for(l = 1; l < n_lanes; l++) {
+    if(vals[l] < array[min] || (vals[l] == array[min] && idx[l] < min)) {
+      min = idx[l];
+    }
+  }
+  for(; i <= iu; i++) {
+    if(array[i] < array[min]) min = i;
+  }
+
+  return min;
+}
+
+/**
+ * @brief Localiza el primer menor elemento de un array con AVX2. Cada 
+ * carril guarda su mínimo y el índice donde apareció por primera vez 
+ * (sólo se actualiza si el nuevo valor es estrictamente menor)
+ * 
+ * @param array el array en el que busca
+ * @param ip primer índice del array
+ * @param iu último índice del array (iu-ip+1 >= 8)
+ * 
+ * @return el índice del primer menor elemento del array
+*/
+__attribute__((target("avx2")))
+static int min_avx2(int* array, int ip, int iu)
+{
+  __m256i vmin, vidx, vcur, v, menor, ocho;
+  int vals[8], idx[8];
+  int i;
+
+  vmin = _mm256_loadu_si256((__m256i*)&array[ip]);
+  vidx = _mm256_setr_epi32(ip, ip+1, ip+2, ip+3, ip+4, ip+5, ip+6, ip+7);
+  vcur = vidx;
+  ocho = _mm256_set1_epi32(8);
+  for(i = ip+8; i+7 <= iu; i += 8) {
+    vcur = _mm256_add_epi32(vcur, ocho);
+    v = _mm256_loadu_si256((__m256i*)&array[i]);
+    menor = _mm256_cmpgt_epi32(vmin, v);
+    vmin = _mm256_blendv_epi8(vmin, v, menor);
+    vidx = _mm256_blendv_epi8(vidx, vcur, menor);
+  }
+
+  _mm256_storeu_si256((__m256i*)vals, vmin);
+  _mm256_storeu_si256((__m256i*)idx, vidx);
+  return min_reduce(array, vals, idx, 8, i, iu);
+}
+
+/**
+ * @brief Localiza el primer menor elemento de un array con SSE4.1, igual 
+ * que min_avx2 pero con carriles de 4 elementos
+ * 
+ * @param array el array en el que busca
+ * @param ip primer índice del array
+ * @param iu último índice del array (iu-ip+1 >= 4)
+ * 
+ * @return el índice del primer menor elemento del array
+*/
+__attribute__((target("sse4.1")))
+static int min_sse41(int* array, int ip, int iu)
+{
+  __m128i vmin, vidx, vcur, v, menor, cuatro;
+  int vals[4], idx[4];
+  int i;
+
+  vmin = _mm_loadu_si128((__m128i*)&array[ip]);
+  vidx = _mm_setr_epi32(ip, ip+1, ip+2, ip+3);
+  vcur = vidx;
+  cuatro = _mm_set1_epi32(4);
+  for(i = ip+4; i+3 <= iu; i += 4) {
+    vcur = _mm_add_epi32(vcur, cuatro);
+    v = _mm_loadu_si128((__m128i*)&array[i]);
+    menor = _mm_cmpgt_epi32(vmin, v);
+    vmin = _mm_blendv_epi8(vmin, v, menor);
+    vidx = _mm_blendv_epi8(vidx, vcur, menor);
+  }
+
+  _mm_storeu_si128((__m128i*)vals, vmin);
+  _mm_storeu_si128((__m128i*)idx, vidx);
+  return min_reduce(array, vals, idx, 4, i, iu);
+}
+
+/**
+ * @brief Localiza el primer menor elemento de un array con AVX2 o SSE4.1 
+ * si la CPU las soporta y el array tiene al menos SIMD_MIN_CUTOFF 
+ * elementos. Es el SORT_MIN_SIMD de min
+ * 
+ * @param array el array en el que busca
+ * @param ip primer índice del array
+ * @param iu último índice del array
+ * 
+ * @return el índice del primer menor elemento o ERR si no se puede usar SIMD
+*/
+static int min_simd(int* array, int ip, int iu)
+{
+  if(iu-ip+1 >= SIMD_MIN_CUTOFF) {
+    switch(simd_level()) {
+      case SIMD_AVX2:
+        return min_avx2(array, ip, iu);
+      case SIMD_SSE41:
+        return min_sse41(array, ip, iu);
+    }
+  }
+  return ERR;
+}
+
+#endif
+
+/**
+ * @brief Ordena de menor a mayor un array por inserción. Es adaptativo: 
+ * con el array ya ordenado realiza iu-ip comparaciones
+ * 
+ * @param array el array a ordenar
+ * @param ip primer índice del array
+ * @param iu último índice del array
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int InsertSort(int* array, int ip, int iu)
+{
+  int i, j, k, count;
+
+  if(array == NULL || ip > iu) return ERR;
+
+  count = 0;
+  for(i = ip+1; i <= iu; i++) {
+    k = array[i];
+    for(j = i-1; j >= ip; j--) {
+      count++;
+      if(array[j] <= k) break;
+      array[j+1] = array[j];
+    }
+    array[j+1] = k;
+  }
+
+  return count;
+}
+
+/**
+ * @brief Ordena de menor a mayor un array por inserción binaria: la 
+ * posición de cada elemento se busca con búsqueda binaria en la parte ya 
+ * ordenada, por lo que hace O(N log N) comparaciones aunque mueva O(N^2) 
+ * elementos
+ * 
+ * @param array el array a ordenar
+ * @param ip primer índice del array
+ * @param iu último índice del array
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int BinInsertSort(int* array, int ip, int iu)
+{
+  int i, j, lo, hi, m, k, count;
+
+  if(array == NULL || ip > iu) return ERR;
+
+  count = 0;
+  for(i = ip+1; i <= iu; i++) {
+    k = array[i];
+    /* Primera posición con un elemento mayor que k, para que sea estable */
+    lo = ip;
+    hi = i;
+    while(lo < hi) {
+      m = (lo+hi)/2;
+      count++;
+      if(k < array[m]) hi = m;
+      else lo = m+1;
+    }
+    for(j = i; j > lo; j--) {
+      array[j] = array[j-1];
+    }
+    array[lo] = k;
+  }
+
+  return count;
+}
+
+/**
+ * @brief Ordena de menor a mayor un array con Shell sort, usando la 
+ * secuencia de saltos de Ciura (1, 4, 10, 23, 57, 132, 301, 701, 1750) 
+ * extendida multiplicando por 2.25
+ * 
+ * @param array el array a ordenar
+ * @param ip primer índice del array
+ * @param iu último índice del array
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int ShellSort(int* array, int ip, int iu)
+{
+  int ciura[] = {1, 4, 10, 23, 57, 132, 301, 701, 1750};
+  int gaps[64];
+  int n_gaps, g, gap, i, j, k, count;
+
+  if(array == NULL || ip > iu) return ERR;
+
+  for(n_gaps = 0; n_gaps < 9 && ciura[n_gaps] < iu-ip+1; n_gaps++) {
+    gaps[n_gaps] = ciura[n_gaps];
+  }
+  if(n_gaps == 9) {
+    while(gaps[n_gaps-1] < (iu-ip+1) / 2.25) {
+      gaps[n_gaps] = (int)(gaps[n_gaps-1] * 2.25);
+      n_gaps++;
+    }
+  }
+
+  count = 0;
+  for(g = n_gaps-1; g >= 0; g--) {
+    gap = gaps[g];
+    for(i = ip+gap; i <= iu; i++) {
+      k = array[i];
+      for(j = i-gap; j >= ip; j -= gap) {
+        count++;
+        if(array[j] <= k) break;
+        array[j+gap] = array[j];
+      }
+      array[j+gap] = k;
+    }
+  }
+
+  return count;
+}
+
+/* redes de ordenación de 2 a NET_MAX elementos: redes odd-even de Batcher 
+   para la potencia de dos siguiente, quitando los comparadores que tocan 
+   posiciones inexistentes (generadas y comprobadas con el principio 0-1) */
+static const unsigned char net_pares[][2] = {
+  /* 2 */
+  {0,1},
+  /* 3 */
+  {0,1}, {0,2}, {1,2},
+  /* 4 */
+  {0,1}, {2,3}, {0,2}, {1,3}, {1,2},
+  /* 5 */
+  {0,1}, {2,3}, {0,2}, {1,3}, {1,2}, {0,4}, {2,4}, {1,2}, {3,4},
+  /* 6 */
+  {0,1}, {2,3}, {4,5}, {0,2}, {1,3}, {1,2}, {0,4}, {1,5}, {2,4}, {3,5},
+  {1,2}, {3,4},
+  /* 7 */
+  {0,1}, {2,3}, {4,5}, {0,2}, {1,3}, {4,6}, {1,2}, {5,6}, {0,4}, {1,5},
+  {2,6}, {2,4}, {3,5}, {1,2}, {3,4}, {5,6},
+  /* 8 */
+  {0,1}, {2,3}, {4,5}, {6,7}, {0,2}, {1,3}, {4,6}, {5,7}, {1,2}, {5,6},
+  {0,4}, {1,5}, {2,6}, {3,7}, {2,4}, {3,5}, {1,2}, {3,4}, {5,6},
+  /* 9 */
+  {0,1}, {2,3}, {4,5}, {6,7}, {0,2}, {1,3}, {4,6}, {5,7}, {1,2}, {5,6},
+  {0,4}, {1,5}, {2,6}, {3,7}, {2,4}, {3,5}, {1,2}, {3,4}, {5,6}, {0,8},
+  {4,8}, {2,4}, {3,5}, {6,8}, {1,2}, {3,4}, {5,6}, {7,8},
+  /* 10 */
+  {0,1}, {2,3}, {4,5}, {6,7}, {8,9}, {0,2}, {1,3}, {4,6}, {5,7}, {1,2},
+  {5,6}, {0,4}, {1,5}, {2,6}, {3,7}, {2,4}, {3,5}, {1,2}, {3,4}, {5,6},
+  {0,8}, {1,9}, {4,8}, {5,9}, {2,4}, {3,5}, {6,8}, {7,9}, {1,2}, {3,4},
+  {5,6}, {7,8},
+  /* 11 */
+  {0,1}, {2,3}, {4,5}, {6,7}, {8,9}, {0,2}, {1,3}, {4,6}, {5,7}, {8,10},
+  {1,2}, {5,6}, {9,10}, {0,4}, {1,5}, {2,6}, {3,7}, {2,4}, {3,5}, {1,2},
+  {3,4}, {5,6}, {9,10}, {0,8}, {1,9}, {2,10}, {4,8}, {5,9}, {6,10}, {2,4},
+  {3,5}, {6,8}, {7,9}, {1,2}, {3,4}, {5,6}, {7,8}, {9,10},
+  /* 12 */
+  {0,1}, {2,3}, {4,5}, {6,7}, {8,9}, {10,11}, {0,2}, {1,3}, {4,6}, {5,7},
+  {8,10}, {9,11}, {1,2}, {5,6}, {9,10}, {0,4}, {1,5}, {2,6}, {3,7}, {2,4},
+  {3,5}, {1,2}, {3,4}, {5,6}, {9,10}, {0,8}, {1,9}, {2,10}, {3,11}, {4,8},
+  {5,9}, {6,10}, {7,11}, {2,4}, {3,5}, {6,8}, {7,9}, {1,2}, {3,4}, {5,6},
+  {7,8}, {9,10},
+  /* 13 */
+  {0,1}, {2,3}, {4,5}, {6,7}, {8,9}, {10,11}, {0,2}, {1,3}, {4,6}, {5,7},
+  {8,10}, {9,11}, {1,2}, {5,6}, {9,10}, {0,4}, {1,5}, {2,6}, {3,7}, {8,12},
+  {2,4}, {3,5}, {10,12}, {1,2}, {3,4}, {5,6}, {9,10}, {11,12}, {0,8},
+  {1,9}, {2,10}, {3,11}, {4,12}, {4,8}, {5,9}, {6,10}, {7,11}, {2,4},
+  {3,5}, {6,8}, {7,9}, {10,12}, {1,2}, {3,4}, {5,6}, {7,8}, {9,10},
+  {11,12},
+  /* 14 */
+  {0,1}, {2,3}, {4,5}, {6,7}, {8,9}, {10,11}, {12,13}, {0,2}, {1,3}, {4,6},
+  {5,7}, {8,10}, {9,11}, {1,2}, {5,6}, {9,10}, {0,4}, {1,5}, {2,6}, {3,7},
+  {8,12}, {9,13}, {2,4}, {3,5}, {10,12}, {11,13}, {1,2}, {3,4}, {5,6},
+  {9,10}, {11,12}, {0,8}, {1,9}, {2,10}, {3,11}, {4,12}, {5,13}, {4,8},
+  {5,9}, {6,10}, {7,11}, {2,4}, {3,5}, {6,8}, {7,9}, {10,12}, {11,13},
+  {1,2}, {3,4}, {5,6}, {7,8}, {9,10}, {11,12},
+  /* 15 */
+  {0,1}, {2,3}, {4,5}, {6,7}, {8,9}, {10,11}, {12,13}, {0,2}, {1,3}, {4,6},
+  {5,7}, {8,10}, {9,11}, {12,14}, {1,2}, {5,6}, {9,10}, {13,14}, {0,4},
+  {1,5}, {2,6}, {3,7}, {8,12}, {9,13}, {10,14}, {2,4}, {3,5}, {10,12},
+  {11,13}, {1,2}, {3,4}, {5,6}, {9,10}, {11,12}, {13,14}, {0,8}, {1,9},
+  {2,10}, {3,11}, {4,12}, {5,13}, {6,14}, {4,8}, {5,9}, {6,10}, {7,11},
+  {2,4}, {3,5}, {6,8}, {7,9}, {10,12}, {11,13}, {1,2}, {3,4}, {5,6}, {7,8},
+  {9,10}, {11,12}, {13,14},
+  /* 16 */
+  {0,1}, {2,3}, {4,5}, {6,7}, {8,9}, {10,11}, {12,13}, {14,15}, {0,2},
+  {1,3}, {4,6}, {5,7}, {8,10}, {9,11}, {12,14}, {13,15}, {1,2}, {5,6},
+  {9,10}, {13,14}, {0,4}, {1,5}, {2,6}, {3,7}, {8,12}, {9,13}, {10,14},
+  {11,15}, {2,4}, {3,5}, {10,12}, {11,13}, {1,2}, {3,4}, {5,6}, {9,10},
+  {11,12}, {13,14}, {0,8}, {1,9}, {2,10}, {3,11}, {4,12}, {5,13}, {6,14},
+  {7,15}, {4,8}, {5,9}, {6,10}, {7,11}, {2,4}, {3,5}, {6,8}, {7,9},
+  {10,12}, {11,13}, {1,2}, {3,4}, {5,6}, {7,8}, {9,10}, {11,12}, {13,14}
+};
+
+/* net_pares[net_inicio[n], net_inicio[n+1]) es la red de n elementos */
+static const int net_inicio[NET_MAX+2] = {
+  0, 0, 0, 1, 4, 9, 18, 30, 46, 65, 93, 125, 163, 205, 253, 306, 365, 428
+};
+
+/* tamaño por debajo del cual quicksort y mergesort usan sortnet (0 = nunca) */
+static int net_cutoff = 0;
+
+/**
+ * @brief Fija el tamaño de tramo por debajo del cual quicksort, 
+ * quicksort_tail y mergesort, de todos los tipos de clave, dejan de 
+ * recurrir y ordenan con sortnet. Con 0 (el valor inicial) recurren 
+ * hasta el final como siempre
+ * 
+ * @param cutoff el nuevo tamaño, entre 0 y NET_MAX
+ * 
+ * @return el tamaño anterior o ERR si cutoff no es válido
+*/
+int set_net_cutoff(int cutoff)
+{
+  int anterior;
+
+  if(cutoff < 0 || cutoff > NET_MAX) return ERR;
+
+  anterior = net_cutoff;
+  net_cutoff = cutoff;
+  return anterior;
+}
+
+/* min, SelectSort, sortnet, mergesort, partition y quicksort para int 
+   (ver sorting_type.h): min usa SIMD y los intercambios se cuentan con 
+   swap. Más abajo están los de los otros tipos de clave */
+
+#define SORT_TYPE int
+#define SORT_NAME(f) f
+#define SORT_PFUNC_PIVOT pfunc_pivot
+#define SORT_SWAP(x, y) swap(x, y)
+#ifdef SORTING_AVX2
+  #define SORT_MIN_SIMD(a, ip, iu) min_simd(a, ip, iu)
+#endif
+#include "sorting_type.h"
+
+/**
+ * @brief Combina las dos subtablas en una tabla auxiliar y esta la copia en la tabla original
+ * 
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param imedio valor medio del número de elementos
+ * 
+ * @return el número de operaciones básicas realizadas
+*/
+int merge(int* tabla, int ip, int iu, int imedio) {
+  int n_obs;
+  int *taux;
+
+  taux = (int*)malloc(sizeof(int) * (iu+1-ip));
+  if(taux == NULL) return ERR;
+
+  n_obs = merge_buf(tabla, ip, iu, imedio, taux);
+
+  free(taux);
+  return n_obs;
+}
+
+/**
+ * @brief Combina los tramos consecutivos [ip, imedio] y [imedio+1, iu] de
+ * src sobre las mismas posiciones de dst, sin copiar de vuelta
+ * 
+ * @param src tabla origen
+ * @param dst tabla destino
+ * @param ip primer elemento del primer tramo
+ * @param iu último elemento del segundo tramo
+ * @param imedio último elemento del primer tramo
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) realizadas
+*/
+static int merge_into(int* src, int* dst, int ip, int iu, int imedio) {
+  int i, j, k, n_obs;
+
+  n_obs = 0;
+  for(i = ip, j = imedio+1, k = ip; (i<=imedio) && (j<=iu); k++) {
+    n_obs++;
+    if(src[j] < src[i]) {
+      dst[k] = src[j];
+      j++;
+    }
+    else {
+      dst[k] = src[i];
+      i++;
+    }
+  }
+
+  while(i <= imedio) dst[k++] = src[i++];
+  while(j <= iu) dst[k++] = src[j++];
+
+  return n_obs;
+}
+
+/**
+ * @brief Ordena de menor a mayor una tabla con un mergesort iterativo 
+ * (de abajo a arriba). Los tramos de MERGE_RUN elementos se ordenan por 
+ * inserción y después se combinan alternando la tabla original y una 
+ * auxiliar como origen y destino, sin copiar de vuelta en cada nivel. 
+ * Si dos tramos ya están en orden no se combinan.
+ * 
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int mergesort_bu(int* tabla, int ip, int iu) {
+  int i, n, width, imedio, ifin, n_obs;
+  int *taux, *src, *dst, *t;
+
+  if(tabla == NULL || ip > iu) return ERR;
+
+  n_obs = 0;
+  for(i = ip; i <= iu; i += MERGE_RUN) {
+    ifin = i + MERGE_RUN - 1;
+    if(ifin > iu) ifin = iu;
+    n_obs += InsertSort(tabla, i, ifin);
+  }
+  if(iu-ip+1 <= MERGE_RUN) return n_obs;
+
+  n = iu-ip+1;
+  taux = (int*)malloc(sizeof(taux[0]) * n);
+  if(taux == NULL) return ERR;
+
+  /* Los tramos se indexan desde 0 tanto en src como en dst */
+  src = &tabla[ip];
+  dst = taux;
+  for(width = MERGE_RUN; width < n; width *= 2) {
+    for(i = 0; i < n; i += 2*width) {
+      imedio = i + width - 1;
+      ifin = i + 2*width - 1;
+      if(ifin > n-1) ifin = n-1;
+
+      if(imedio >= ifin) {
+        /* Tramo sin pareja */
+        memcpy(&dst[i], &src[i], sizeof(src[0]) * (ifin+1-i));
+        break;
+      }
+
+      n_obs++;
+      if(src[imedio] <= src[imedio+1]) {
+        /* Los tramos ya están en orden */
+        memcpy(&dst[i], &src[i], sizeof(src[0]) * (ifin+1-i));
+      }
+      else {
+        n_obs += merge_into(src, dst, i, ifin, imedio);
+      }
+    }
+    t = src;
+    src = dst;
+    dst = t;
+  }
+
+  if(src != &tabla[ip]) {
+    memcpy(&tabla[ip], src, sizeof(tabla[0]) * n);
+  }
+
+  free(taux);
+  return n_obs;
+}
+
+
+
+/**
+ * @brief Reserva un árbol de perdedores para k fuentes ordenadas. El 
+ * llamante rellena cab y fin (cabeza INT_MAX y fin a 1 para una fuente 
+ * agotada) y después llama a ltree_build
+ * 
+ * @param k número de fuentes (al menos 1)
+ * 
+ * @return el árbol o NULL en caso de error
+*/
+PLTREE ltree_create(int k) {
+  PLTREE t;
+
+  if(k < 1) return NULL;
+
+  t = (PLTREE)malloc(sizeof(t[0]));
+  if(t == NULL) return NULL;
+
+  t->k = k;
+  t->n_obs = 0;
+  t->arbol = (int*)malloc(sizeof(t->arbol[0]) * k);
+  t->cab = (int*)malloc(sizeof(t->cab[0]) * k);
+  t->fin = (char*)calloc(k, sizeof(t->fin[0]));
+  if(t->arbol == NULL || t->cab == NULL || t->fin == NULL) {
+    ltree_free(t);
+    return NULL;
+  }
+
+  return t;
+}
+
+/**
+ * @brief Libera un árbol de perdedores
+ * 
+ * @param t el árbol
+*/
+void ltree_free(PLTREE t) {
+  if(t == NULL) return;
+
+  free(t->arbol);
+  free(t->cab);
+  free(t->fin);
+  free(t);
+}
+
+/**
+ * @brief Indica si la fuente a gana a la fuente b: la de menor cabeza y, 
+ * a igualdad, la no agotada y después la de menor índice, para que la 
+ * combinación sea estable. Las fuentes agotadas tienen como cabeza 
+ * INT_MAX, así que sólo se mira fin en los empates
+ * 
+ * @param t el árbol
+ * @param a primera fuente
+ * @param b segunda fuente
+ * 
+ * @return 1 si gana a, 0 si gana b
+*/
+static int ltree_gana(PLTREE t, int a, int b) {
+  t->n_obs++;
+  if(t->cab[a] != t->cab[b]) return t->cab[a] < t->cab[b];
+  if(t->fin[a] != t->fin[b]) return t->fin[b];
+  return a < b;
+}
+
+/**
+ * @brief Actualiza el árbol después de cambiar la cabeza (o fin) de la 
+ * fuente s: sube desde su hoja dejando el perdedor en cada nodo, y el 
+ * ganador final queda en arbol[0]. Cuesta unas log2(k) comparaciones. 
+ * Una fuente agotada debe tener fin a 1 y cabeza INT_MAX
+ * 
+ * @param t el árbol
+ * @param s la fuente que ha cambiado
+*/
+void ltree_replace(PLTREE t, int s) {
+  int n, x;
+
+  for(n = (s+t->k)/2; n > 0; n /= 2) {
+    x = t->arbol[n];
+    /* Durante ltree_build los nodos aún vacíos valen k y no juegan */
+    if(x != t->k && ltree_gana(t, x, s)) {
+      t->arbol[n] = s;
+      s = x;
+    }
+    else if(x == t->k) {
+      t->arbol[n] = s;
+      return;
+    }
+  }
+  t->arbol[0] = s;
+}
+
+/**
+ * @brief Construye el árbol a partir de las cabezas de todas las fuentes. 
+ * Parte de un árbol vacío (todos los nodos valen k) y va subiendo cada 
+ * fuente hasta el primer nodo vacío, de la última a la primera
+ * 
+ * @param t el árbol
+*/
+void ltree_build(PLTREE t) {
+  int s;
+
+  for(s = 0; s < t->k; s++) t->arbol[s] = t->k;
+  for(s = t->k-1; s >= 0; s--) ltree_replace(t, s);
+}
+
+/**
+ * @brief Combina de forma estable k tramos ordenados en una tabla de 
+ * salida en una sola pasada con un árbol de perdedores, en lugar de las 
+ * log2(k) pasadas de combinar los tramos de dos en dos con merge
+ * 
+ * @param runs puntero al primer elemento de cada tramo
+ * @param lens número de elementos de cada tramo
+ * @param k número de tramos
+ * @param salida tabla de salida con espacio para la suma de lens, que no 
+ * se solapa con los tramos
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) realizadas
+*/
+int merge_k(int** runs, int* lens, int k, int* salida) {
+  PLTREE t;
+  int *pos;
+  int i, w, n_obs;
+
+  if(runs == NULL || lens == NULL || salida == NULL || k < 1) return ERR;
+
+  t = ltree_create(k);
+  pos = (int*)calloc(k, sizeof(pos[0]));
+  if(t == NULL || pos == NULL) {
+    ltree_free(t);
+    free(pos);
+    return ERR;
+  }
+
+  for(i = 0; i < k; i++) {
+    t->fin[i] = (lens[i] <= 0);
+    t->cab[i] = t->fin[i] ? INT_MAX : runs[i][0];
+  }
+  ltree_build(t);
+
+  while(!t->fin[LTREE_WINNER(t)]) {
+    w = LTREE_WINNER(t);
+    *salida++ = t->cab[w];
+    if(++pos[w] < lens[w]) t->cab[w] = runs[w][pos[w]];
+    else {
+      t->cab[w] = INT_MAX;
+      t->fin[w] = 1;
+    }
+    ltree_replace(t, w);
+  }
+
+  n_obs = (int)t->n_obs;
+  ltree_free(t);
+  free(pos);
+  return n_obs;
+}
+
+/**
+ * @brief Ordena de menor a mayor una tabla con un mergesort iterativo de 
+ * k vías: los tramos de MERGE_RUN elementos se ordenan por inserción y se 
+ * combinan de k en k con merge_k alternando la tabla y una auxiliar, de 
+ * modo que hay log_k(N/MERGE_RUN) pasadas en lugar de log2
+ * 
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param k número de tramos que se combinan a la vez (al menos 2)
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int mergesort_k(int* tabla, int ip, int iu, int k) {
+  int **runs;
+  int *lens, *taux, *src, *dst, *tmp;
+  int i, j, r, n, width, ifin, n_obs, st;
+
+  if(tabla == NULL || ip > iu || k < 2) return ERR;
+
+  n_obs = 0;
+  for(i = ip; i <= iu; i += MERGE_RUN) {
+    ifin = (i+MERGE_RUN-1 < iu) ? i+MERGE_RUN-1 : iu;
+    n_obs += InsertSort(tabla, i, ifin);
+  }
+  n = iu-ip+1;
+  if(n <= MERGE_RUN) return n_obs;
+
+  taux = (int*)malloc(sizeof(taux[0]) * n);
+  runs = (int**)malloc(sizeof(runs[0]) * k);
+  lens = (int*)malloc(sizeof(lens[0]) * k);
+  if(taux == NULL || runs == NULL || lens == NULL) {
+    free(taux);
+    free(runs);
+    free(lens);
+    return ERR;
+  }
+
+  /* Los tramos se indexan desde 0 tanto en src como en dst */
+  src = &tabla[ip];
+  dst = taux;
+  for(width = MERGE_RUN; width < n; width = (width > n/k) ? n : width*k) {
+    for(i = 0; i < n; i += width*k) {
+      for(r = 0, j = i; r < k && j < n; r++, j += width) {
+        runs[r] = &src[j];
+        lens[r] = (j+width <= n) ? width : n-j;
+      }
+      if(r == 1) {
+        memcpy(&dst[i], &src[i], sizeof(src[0]) * lens[0]);
+        continue;
+      }
+      st = merge_k(runs, lens, r, &dst[i]);
+      if(st == ERR) {
+        free(taux);
+        free(runs);
+        free(lens);
+        return ERR;
+      }
+      n_obs += st;
+    }
+    tmp = src;
+    src = dst;
+    dst = tmp;
+  }
+
+  if(src != &tabla[ip]) {
+    memcpy(&tabla[ip], src, sizeof(tabla[0]) * n);
+  }
+
+  free(taux);
+  free(runs);
+  free(lens);
+  return n_obs;
+}
+
+/**
+ * @brief Ordena de menor a mayor una tabla con mergesort_k de MERGE_K vías
+ * 
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int mergesort_kway(int* tabla, int ip, int iu) {
+  return mergesort_k(tabla, ip, iu, MERGE_K);
+}
+
+
+/**
+ * @brief Invierte el tramo [ip, iu] de la tabla
+ * 
+ * @param tabla la tabla
+ * @param ip primer elemento del tramo
+ * @param iu último elemento del tramo
+ * @param n_movs contador de movimientos de elementos
+*/
+static void inplace_reverse(int* tabla, int ip, int iu, long *n_movs) {
+  int x;
+
+  *n_movs += 3L * ((iu-ip+1)/2);
+  for(; ip < iu; ip++, iu--) {
+    x = tabla[ip];
+    tabla[ip] = tabla[iu];
+    tabla[iu] = x;
+  }
+}
+
+/**
+ * @brief Combina sin tabla auxiliar los tramos consecutivos ordenados 
+ * [ip, imedio] y [imedio+1, iu] de forma estable. Si el menor de los dos 
+ * cabe en INPLACE_BUF elementos se combina a través de un buffer fijo en 
+ * la pila; si no, se parte el tramo mayor por la mitad, se busca con 
+ * búsqueda binaria dónde cae su elemento central en el otro tramo, se 
+ * rotan los dos trozos intermedios y se combinan recursivamente las dos 
+ * mitades resultantes
+ * 
+ * @param tabla la tabla
+ * @param ip primer elemento del primer tramo
+ * @param iu último elemento del segundo tramo
+ * @param imedio último elemento del primer tramo
+ * @param n_movs contador de movimientos de elementos
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) realizadas
+*/
+static int merge_inplace(int* tabla, int ip, int iu, int imedio, long *n_movs) {
+  int buf[INPLACE_BUF];
+  int la, lb, i, j, k, lo, hi, m, corte1, corte2, nuevo_medio, n_obs;
+
+  la = imedio-ip+1;
+  lb = iu-imedio;
+  if(la == 0 || lb == 0) return 0;
+
+  n_obs = 0;
+  if(la <= INPLACE_BUF && la <= lb) {
+    /* Hacia delante con el primer tramo en buf */
+    memcpy(buf, &tabla[ip], sizeof(buf[0]) * la);
+    *n_movs += la;
+    for(i = 0, j = imedio+1, k = ip; i < la && j <= iu; k++) {
+      n_obs++;
+      if(tabla[j] < buf[i]) tabla[k] = tabla[j++];
+      else tabla[k] = buf[i++];
+    }
+    memcpy(&tabla[k], &buf[i], sizeof(buf[0]) * (la-i));
+    *n_movs += (k-ip) + (la-i);
+    return n_obs;
+  }
+  if(lb <= INPLACE_BUF) {
+    /* Hacia atrás con el segundo tramo en buf */
+    memcpy(buf, &tabla[imedio+1], sizeof(buf[0]) * lb);
+    *n_movs += lb;
+    for(i = imedio, j = lb-1, k = iu; i >= ip && j >= 0; k--) {
+      n_obs++;
+      if(buf[j] < tabla[i]) tabla[k] = tabla[i--];
+      else tabla[k] = buf[j--];
+    }
+    memcpy(&tabla[ip], buf, sizeof(buf[0]) * (j+1));
+    *n_movs += (iu-k) + (j+1);
+    return n_obs;
+  }
+
+  if(la > lb) {
+    /* Primer elemento del segundo tramo no menor que el central del primero */
+    corte1 = ip + la/2;
+    lo = imedio+1;
+    hi = iu+1;
+    while(lo < hi) {
+      m = (lo+hi)/2;
+      n_obs++;
+      if(tabla[m] < tabla[corte1]) lo = m+1;
+      else hi = m;
+    }
+    corte2 = lo;
+  }
+  else {
+    /* Primer elemento del primer tramo mayor que el central del segundo */
+    corte2 = imedio+1 + lb/2;
+    lo = ip;
+    hi = imedio+1;
+    while(lo < hi) {
+      m = (lo+hi)/2;
+      n_obs++;
+      if(tabla[corte2] < tabla[m]) hi = m;
+      else lo = m+1;
+    }
+    corte1 = lo;
+  }
+
+  /* Rota [corte1, imedio] y [imedio+1, corte2) */
+  inplace_reverse(tabla, corte1, imedio, n_movs);
+  inplace_reverse(tabla, imedio+1, corte2-1, n_movs);
+  inplace_reverse(tabla, corte1, corte2-1, n_movs);
+  nuevo_medio = corte1 + (corte2-imedio-1);
+
+  n_obs += merge_inplace(tabla, ip, nuevo_medio-1, corte1-1, n_movs);
+  n_obs += merge_inplace(tabla, nuevo_medio, iu, corte2-1, n_movs);
+
+  return n_obs;
+}
+
+/**
+ * @brief Paso recursivo de mergesort_inplace_cnt
+ * 
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param n_movs contador de movimientos de elementos
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) realizadas
+*/
+static int mergesort_inplace_rec(int* tabla, int ip, int iu, long *n_movs) {
+  int i, j, k, medio, n_obs;
+
+  if(iu-ip+1 <= MERGE_RUN) {
+    /* Inserción, contando los movimientos */
+    n_obs = 0;
+    for(i = ip+1; i <= iu; i++) {
+      k = tabla[i];
+      for(j = i-1; j >= ip; j--) {
+        n_obs++;
+        if(tabla[j] <= k) break;
+        tabla[j+1] = tabla[j];
+        (*n_movs)++;
+      }
+      if(j+1 != i) {
+        tabla[j+1] = k;
+        (*n_movs)++;
+      }
+    }
+    return n_obs;
+  }
+
+  medio = (ip+iu)/2;
+  n_obs = mergesort_inplace_rec(tabla, ip, medio, n_movs);
+  n_obs += mergesort_inplace_rec(tabla, medio+1, iu, n_movs);
+
+  n_obs++;
+  if(tabla[medio+1] < tabla[medio]) {
+    n_obs += merge_inplace(tabla, ip, iu, medio, n_movs);
+  }
+
+  return n_obs;
+}
+
+/**
+ * @brief Ordena de menor a mayor una tabla con un mergesort estable que 
+ * no reserva memoria: los tramos de MERGE_RUN elementos se ordenan por 
+ * inserción y se combinan con merge_inplace, que sólo usa un buffer fijo 
+ * de INPLACE_BUF elementos en la pila. Realiza O(N log^2 N) movimientos
+ * 
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param n_movs si no es NULL, devuelve los movimientos de elementos realizados
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int mergesort_inplace_cnt(int* tabla, int ip, int iu, long *n_movs) {
+  long movs;
+  int n_obs;
+
+  if(tabla == NULL || ip > iu) return ERR;
+
+  movs = 0;
+  n_obs = mergesort_inplace_rec(tabla, ip, iu, &movs);
+  if(n_movs != NULL) *n_movs = movs;
+
+  return n_obs;
+}
+
+/**
+ * @brief Ordena de menor a mayor una tabla con mergesort_inplace_cnt
+ * 
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int mergesort_inplace(int* tabla, int ip, int iu) {
+  return mergesort_inplace_cnt(tabla, ip, iu, NULL);
+}
+
+
+
+/* argumentos de las tareas de mergesort_par */
+typedef struct {
+  PPOOL pool;
+  int *tabla;
+  int *taux;     /* tabla auxiliar indexada igual que tabla */
+  int ip, iu;
+  int n_obs;
+} MSORT_ARGS;
+
+typedef struct {
+  int *tabla;
+  int *taux;
+  int ip, iu, imedio;
+  int kp, ku;    /* posiciones [kp, ku) de la salida que combina la tarea */
+} MERGE_ARGS;
+
+/**
+ * @brief Calcula cuántos elementos del primer tramo hay entre los k 
+ * primeros de la combinación de [ip, imedio] y [imedio+1, iu], con el 
+ * mismo desempate que merge_buf (co-ranking)
+ * 
+ * @param tabla la tabla
+ * @param ip primer elemento del primer tramo
+ * @param iu último elemento del segundo tramo
+ * @param imedio último elemento del primer tramo
+ * @param k número de elementos de la salida
+ * 
+ * @return el número de elementos del primer tramo
+*/
+static int merge_corank(int* tabla, int ip, int iu, int imedio, int k) {
+  int n1, n2, lo, hi, i;
+
+  n1 = imedio-ip+1;
+  n2 = iu-imedio;
+  lo = (k > n2) ? k-n2 : 0;
+  hi = (k < n1) ? k : n1;
+  while(lo < hi) {
+    i = (lo+hi)/2;
+    if(tabla[ip+i] < tabla[imedio+k-i]) lo = i+1;
+    else hi = i;
+  }
+
+  return lo;
+}
+
+/**
+ * @brief Calcula las comparaciones de clave que haría merge_buf sobre los 
+ * mismos tramos: todos los elementos menos los que se copian tras 
+ * agotarse uno de los tramos
+ * 
+ * @param tabla la tabla
+ * @param ip primer elemento del primer tramo
+ * @param iu último elemento del segundo tramo
+ * @param imedio último elemento del primer tramo
+ * 
+ * @return el número de operaciones básicas de merge_buf
+*/
+static int merge_count(int* tabla, int ip, int iu, int imedio) {
+  int lo, hi, i;
+
+  if(tabla[imedio] < tabla[iu]) {
+    /* Se agota el primer tramo: sobran los del segundo mayores que su último */
+    lo = imedio+1;
+    hi = iu+1;
+    while(lo < hi) {
+      i = (lo+hi)/2;
+      if(tabla[i] <= tabla[imedio]) lo = i+1;
+      else hi = i;
+    }
+    return (iu-ip+1) - (iu+1-lo);
+  }
+
+  /* Se agota el segundo tramo: sobran los del primero no menores que su último */
+  lo = ip;
+  hi = imedio+1;
+  while(lo < hi) {
+    i = (lo+hi)/2;
+    if(tabla[i] < tabla[iu]) lo = i+1;
+    else hi = i;
+  }
+  return (iu-ip+1) - (imedio+1-lo);
+}
+
+/**
+ * @brief Tarea que combina el segmento [kp, ku) de la salida en taux
+ * 
+ * @param arg puntero a MERGE_ARGS
+*/
+static void merge_par_task(void *arg) {
+  MERGE_ARGS *m = (MERGE_ARGS*)arg;
+  int i, j, k, ifin, jfin;
+
+  i = m->ip + merge_corank(m->tabla, m->ip, m->iu, m->imedio, m->kp);
+  j = m->imedio+1 + m->kp - (i - m->ip);
+  ifin = m->ip + merge_corank(m->tabla, m->ip, m->iu, m->imedio, m->ku);
+  jfin = m->imedio+1 + m->ku - (ifin - m->ip);
+
+  for(k = m->ip + m->kp; i < ifin && j < jfin; k++) {
+    if(m->tabla[i] < m->tabla[j]) m->taux[k] = m->tabla[i++];
+    else m->taux[k] = m->tabla[j++];
+  }
+  while(i < ifin) m->taux[k++] = m->tabla[i++];
+  while(j < jfin) m->taux[k++] = m->tabla[j++];
+}
+
+/**
+ * @brief Tarea que copia el segmento [kp, ku) de la salida de taux a tabla
+ * 
+ * @param arg puntero a MERGE_ARGS
+*/
+static void copy_par_task(void *arg) {
+  MERGE_ARGS *m = (MERGE_ARGS*)arg;
+
+  memcpy(&m->tabla[m->ip + m->kp], &m->taux[m->ip + m->kp], sizeof(m->tabla[0]) * (m->ku - m->kp));
+}
+
+/**
+ * @brief Combina [ip, imedio] y [imedio+1, iu] repartiendo la salida en 
+ * segmentos de al menos PAR_CUTOFF elementos que se combinan en paralelo
+ * 
+ * @param pool el pool de hilos
+ * @param tabla la tabla
+ * @param taux tabla auxiliar indexada igual que tabla
+ * @param ip primer elemento del primer tramo
+ * @param iu último elemento del segundo tramo
+ * @param imedio último elemento del primer tramo
+ * 
+ * @return el número de operaciones básicas que haría merge_buf o ERR
+*/
+static int merge_par(PPOOL pool, int* tabla, int* taux, int ip, int iu, int imedio) {
+  MERGE_ARGS *args;
+  TASK *tasks;
+  int s, n, n_seg, n_obs;
+
+  n = iu-ip+1;
+  n_seg = n / PAR_CUTOFF;
+  if(n_seg > pool_n_threads(pool)) n_seg = pool_n_threads(pool);
+  if(n_seg < 1) n_seg = 1;
+
+  args = (MERGE_ARGS*)malloc(sizeof(args[0]) * n_seg);
+  tasks = (TASK*)malloc(sizeof(tasks[0]) * n_seg);
+  if(args == NULL || tasks == NULL) {
+    free(args);
+    free(tasks);
+    return ERR;
+  }
+
+  /* El número de comparaciones se calcula antes de mover nada */
+  n_obs = merge_count(tabla, ip, iu, imedio);
+
+  for(s = 0; s < n_seg; s++) {
+    args[s].tabla = tabla;
+    args[s].taux = taux;
+    args[s].ip = ip;
+    args[s].iu = iu;
+    args[s].imedio = imedio;
+    args[s].kp = (int)((double)n * s / n_seg);
+    args[s].ku = (int)((double)n * (s+1) / n_seg);
+  }
+
+  for(s = 1; s < n_seg; s++) pool_submit(pool, &tasks[s], merge_par_task, &args[s]);
+  merge_par_task(&args[0]);
+  for(s = 1; s < n_seg; s++) pool_wait(pool, &tasks[s]);
+
+  for(s = 1; s < n_seg; s++) pool_submit(pool, &tasks[s], copy_par_task, &args[s]);
+  copy_par_task(&args[0]);
+  for(s = 1; s < n_seg; s++) pool_wait(pool, &tasks[s]);
+
+  free(args);
+  free(tasks);
+  return n_obs;
+}
+
+/**
+ * @brief Tarea de mergesort_par: por debajo de PAR_CUTOFF elementos llama 
+ * a mergesort_buf; por encima ordena la primera mitad en otra tarea, la 
+ * segunda en este hilo y las combina con merge_par
+ * 
+ * @param arg puntero a MSORT_ARGS
+*/
+static void mergesort_par_task(void *arg) {
+  MSORT_ARGS *a = (MSORT_ARGS*)arg;
+  MSORT_ARGS izq, der;
+  TASK task;
+  int medio;
+
+  if(a->iu-a->ip+1 <= PAR_CUTOFF) {
+    a->n_obs = mergesort_buf(a->tabla, a->ip, a->iu, &a->taux[a->ip]);
+    return;
+  }
+
+  medio = (a->ip+a->iu)/2;
+  izq = *a;
+  izq.iu = medio;
+  der = *a;
+  der.ip = medio+1;
+
+  pool_submit(a->pool, &task, mergesort_par_task, &izq);
+  mergesort_par_task(&der);
+  pool_wait(a->pool, &task);
+
+  if(izq.n_obs == ERR || der.n_obs == ERR) {
+    a->n_obs = ERR;
+    return;
+  }
+
+  a->n_obs = merge_par(a->pool, a->tabla, a->taux, a->ip, a->iu, medio);
+  if(a->n_obs != ERR) a->n_obs += izq.n_obs + der.n_obs;
+}
+
+/**
+ * @brief Ordena de menor a mayor una tabla con mergesort en paralelo 
+ * usando n_threads hilos. Divide la tabla igual que mergesort, por lo 
+ * que devuelve el mismo número de operaciones básicas
+ * 
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param n_threads número de hilos
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int mergesort_par_n(int* tabla, int ip, int iu, int n_threads) {
+  MSORT_ARGS a;
+  int *taux;
+
+  if(tabla == NULL || ip > iu || n_threads < 1) return ERR;
+
+  if(n_threads == 1 || iu-ip+1 <= PAR_CUTOFF) return mergesort(tabla, ip, iu);
+
+  taux = (int*)malloc(sizeof(taux[0]) * (iu+1-ip));
+  if(taux == NULL) return ERR;
+
+  a.pool = pool_create(n_threads);
+  if(a.pool == NULL) {
+    free(taux);
+    return ERR;
+  }
+
+  /* taux[0] corresponde a tabla[ip] */
+  a.tabla = &tabla[ip];
+  a.taux = taux;
+  a.ip = 0;
+  a.iu = iu-ip;
+  mergesort_par_task(&a);
+
+  pool_free(a.pool);
+  free(taux);
+  return a.n_obs;
+}
+
+/**
+ * @brief Ordena de menor a mayor una tabla con mergesort en paralelo 
+ * usando todos los procesadores disponibles
+ * 
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int mergesort_par(int* tabla, int ip, int iu) {
+  return mergesort_par_n(tabla, ip, iu, pool_default_threads());
+}
+
+/* estado compartido de samplesort_n */
+typedef struct {
+  int *tabla;              /* tabla a ordenar, desde la posición 0 */
+  int *taux;               /* salida del reparto en cubetas */
+  unsigned char *cubeta;   /* cubeta de cada elemento */
+  int arbol[SAMPLE_BUCKETS];   /* separadores en orden de anchura, desde 1 */
+  int *hist;               /* elementos de cada trozo en cada cubeta */
+  int *inicio;             /* primera posición de cada cubeta, más el final */
+  int n, n_trozos;
+} SSORT;
+
+/* argumentos de cada tarea de samplesort_n */
+typedef struct {
+  SSORT *s;
+  int id;       /* trozo o cubeta que procesa la tarea */
+  int n_obs;
+  long n_swaps; /* intercambios hechos por la tarea */
+} SSORT_ARGS;
+
+/**
+ * @brief Clasifica los elementos de un trozo en cubetas bajando por el 
+ * árbol de separadores sin saltos condicionales y cuenta cuántos caen 
+ * en cada cubeta
+ * 
+ * @param arg puntero a SSORT_ARGS
+*/
+static void samplesort_classify_task(void *arg) {
+  SSORT_ARGS *a = (SSORT_ARGS*)arg;
+  SSORT *s = a->s;
+  int i, j, l, ip, iu, x;
+  int *hist;
+
+  ip = (int)((double)s->n * a->id / s->n_trozos);
+  iu = (int)((double)s->n * (a->id+1) / s->n_trozos);
+  hist = &s->hist[a->id * SAMPLE_BUCKETS];
+
+  for(i = ip; i < iu; i++) {
+    x = s->tabla[i];
+    j = 1;
+    for(l = 0; l < SAMPLE_LEVELS; l++) {
+      j = 2*j + (x > s->arbol[j]);
+    }
+    j -= SAMPLE_BUCKETS;
+    s->cubeta[i] = (unsigned char)j;
+    hist[j]++;
+  }
+
+  a->n_obs = (iu-ip) * SAMPLE_LEVELS;
+}
+
+/**
+ * @brief Copia los elementos de un trozo a su cubeta en taux
+ * 
+ * @param arg puntero a SSORT_ARGS
+*/
+static void samplesort_scatter_task(void *arg) {
+  SSORT_ARGS *a = (SSORT_ARGS*)arg;
+  SSORT *s = a->s;
+  int i, ip, iu;
+  int *pos;
+
+  ip = (int)((double)s->n * a->id / s->n_trozos);
+  iu = (int)((double)s->n * (a->id+1) / s->n_trozos);
+  pos = &s->hist[a->id * SAMPLE_BUCKETS];
+
+  for(i = ip; i < iu; i++) {
+    s->taux[pos[s->cubeta[i]]++] = s->tabla[i];
+  }
+}
+
+/**
+ * @brief Ordena una cubeta con introsort y la copia a la tabla. Guarda 
+ * los intercambios hechos, que se cuentan en el hilo que la ejecuta
+ * 
+ * @param arg puntero a SSORT_ARGS
+*/
+static void samplesort_bucket_task(void *arg) {
+  SSORT_ARGS *a = (SSORT_ARGS*)arg;
+  SSORT *s = a->s;
+  int ip, iu;
+  long n_swaps;
+
+  ip = s->inicio[a->id];
+  iu = s->inicio[a->id+1]-1;
+  a->n_obs = 0;
+  a->n_swaps = 0;
+  if(ip > iu) return;
+
+  n_swaps = swap_count();
+  a->n_obs = introsort(s->taux, ip, iu);
+  a->n_swaps = swap_count() - n_swaps;
+  memcpy(&s->tabla[ip], &s->taux[ip], sizeof(s->tabla[0]) * (iu-ip+1));
+}
+
+/**
+ * @brief Ejecuta n tareas en el pool, la primera en el hilo llamante
+ * 
+ * @param pool el pool de hilos
+ * @param tasks tareas del pool
+ * @param func función de las tareas
+ * @param args argumentos de cada tarea
+ * @param n número de tareas
+*/
+static void samplesort_run(PPOOL pool, TASK *tasks, pfunc_task func, SSORT_ARGS *args, int n) {
+  int i;
+
+  for(i = 1; i < n; i++) pool_submit(pool, &tasks[i], func, &args[i]);
+  func(&args[0]);
+  for(i = 1; i < n; i++) pool_wait(pool, &tasks[i]);
+}
+
+/**
+ * @brief Ordena la tabla con sample sort en paralelo usando n_threads 
+ * hilos. Toma una muestra de SAMPLE_OVERSAMPLE*SAMPLE_BUCKETS elementos 
+ * para elegir los separadores, reparte la tabla en SAMPLE_BUCKETS cubetas 
+ * (clasificación y copia en paralelo por trozos) y ordena las cubetas en 
+ * paralelo con introsort. Por debajo de SAMPLE_CUTOFF elementos usa 
+ * directamente introsort
+ * 
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param n_threads número de hilos
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int samplesort_n(int* tabla, int ip, int iu, int n_threads) {
+  SSORT s;
+  SSORT_ARGS *args;
+  TASK *tasks;
+  PPOOL pool;
+  int muestra[SAMPLE_OVERSAMPLE*SAMPLE_BUCKETS];
+  int i, j, l, q, t, acum, n_obs, n_tareas;
+  long n_swaps;
+
+  if(tabla == NULL || ip > iu || n_threads < 1) return ERR;
+
+  if(iu-ip+1 < SAMPLE_CUTOFF) return introsort(tabla, ip, iu);
+
+  s.tabla = &tabla[ip];
+  s.n = iu-ip+1;
+  s.n_trozos = n_threads;
+  n_tareas = (SAMPLE_BUCKETS > n_threads) ? SAMPLE_BUCKETS : n_threads;
+
+  /* Separadores: cada SAMPLE_OVERSAMPLE elementos de la muestra ordenada */
+  for(i = 0; i < SAMPLE_OVERSAMPLE*SAMPLE_BUCKETS; i++) {
+    muestra[i] = s.tabla[random_num(0, s.n-1)];
+  }
+  n_obs = introsort(muestra, 0, SAMPLE_OVERSAMPLE*SAMPLE_BUCKETS-1);
+
+  /* Árbol en orden de anchura: el nodo j tiene hijos 2j y 2j+1 y el 
+     nodo q del nivel l guarda el separador de rango (2q+1)*SAMPLE_BUCKETS/2^(l+1) */
+  for(l = 0, j = 1; l < SAMPLE_LEVELS; l++) {
+    for(q = 0; q < (1 << l); q++, j++) {
+      s.arbol[j] = muestra[(2*q+1) * (SAMPLE_BUCKETS >> (l+1)) * SAMPLE_OVERSAMPLE - 1];
+    }
+  }
+
+  s.taux = (int*)malloc(sizeof(s.taux[0]) * s.n);
+  s.cubeta = (unsigned char*)malloc(sizeof(s.cubeta[0]) * s.n);
+  s.hist = (int*)calloc(n_threads * SAMPLE_BUCKETS, sizeof(s.hist[0]));
+  s.inicio = (int*)malloc(sizeof(s.inicio[0]) * (SAMPLE_BUCKETS+1));
+  args = (SSORT_ARGS*)malloc(sizeof(args[0]) * n_tareas);
+  tasks = (TASK*)malloc(sizeof(tasks[0]) * n_tareas);
+  pool = pool_create(n_threads);
+  if(s.taux == NULL || s.cubeta == NULL || s.hist == NULL || s.inicio == NULL || 
+     args == NULL || tasks == NULL || pool == NULL) {
+    free(s.taux);
+    free(s.cubeta);
+    free(s.hist);
+    free(s.inicio);
+    free(args);
+    free(tasks);
+    pool_free(pool);
+    return ERR;
+  }
+
+  for(i = 0; i < n_tareas; i++) {
+    args[i].s = &s;
+    args[i].id = i;
+    args[i].n_obs = 0;
+    args[i].n_swaps = 0;
+  }
+
+  samplesort_run(pool, tasks, samplesort_classify_task, args, n_threads);
+  for(i = 0; i < n_threads; i++) n_obs += args[i].n_obs;
+
+  /* Cada trozo escribe en su cubeta a continuación de los trozos anteriores */
+  for(j = 0, acum = 0; j < SAMPLE_BUCKETS; j++) {
+    s.inicio[j] = acum;
+    for(i = 0; i < n_threads; i++) {
+      t = s.hist[i*SAMPLE_BUCKETS + j];
+      s.hist[i*SAMPLE_BUCKETS + j] = acum;
+      acum += t;
+    }
+  }
+  s.inicio[SAMPLE_BUCKETS] = acum;
+
+  samplesort_run(pool, tasks, samplesort_scatter_task, args, n_threads);
+
+  /* El llamante también ejecuta cubetas mientras espera y ya tiene sus 
+     intercambios contados: sólo se suman los de los otros hilos */
+  n_swaps = swap_count();
+  samplesort_run(pool, tasks, samplesort_bucket_task, args, SAMPLE_BUCKETS);
+  n_swaps = -(swap_count() - n_swaps);
+  for(i = 0; i < SAMPLE_BUCKETS; i++) {
+    n_obs += args[i].n_obs;
+    n_swaps += args[i].n_swaps;
+  }
+  add_swap_count(n_swaps);
+
+  pool_free(pool);
+  free(s.taux);
+  free(s.cubeta);
+  free(s.hist);
+  free(s.inicio);
+  free(args);
+  free(tasks);
+  return n_obs;
+}
+
+/**
+ * @brief Ordena la tabla con sample sort en paralelo usando todos los 
+ * procesadores disponibles
+ * 
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int samplesort(int* tabla, int ip, int iu) {
+  return samplesort_n(tabla, ip, iu, pool_default_threads());
+}
+
+/**
+ * @brief Busca con búsqueda exponencial seguida de binaria la posición 
+ * de key en la tabla ordenada a[0, n)
+ * 
+ * @param key clave a buscar
+ * @param a la tabla ordenada
+ * @param n número de elementos de la tabla
+ * @param derecha 1 para devolver cuántos elementos son menores o iguales 
+ * que key, 0 para devolver cuántos son estrictamente menores
+ * @param desde_final 1 si se espera la posición cerca del final de la tabla
+ * @param n_obs contador de operaciones básicas
+ * 
+ * @return la posición de key
+*/
+static int gallop(int key, int* a, int n, int derecha, int desde_final, int *n_obs) {
+  int lo, hi, m, ofs;
+
+  /* antes(x) es cierto si x va delante de la posición buscada */
+#define antes(x) ((*n_obs)++, derecha ? ((x) <= key) : ((x) < key))
+  if(!desde_final) {
+    lo = 0;
+    ofs = 1;
+    while(ofs <= n && antes(a[ofs-1])) {
+      lo = ofs;
+      ofs *= 2;
+    }
+    hi = (ofs-1 < n) ? ofs-1 : n;
+  }
+  else {
+    hi = n;
+    ofs = 1;
+    while(ofs <= n && !antes(a[n-ofs])) {
+      hi = n-ofs;
+      ofs *= 2;
+    }
+    lo = (n-ofs+1 > 0) ? n-ofs+1 : 0;
+  }
+
+  while(lo < hi) {
+    m = (lo+hi)/2;
+    if(antes(a[m])) lo = m+1;
+    else hi = m;
+  }
+#undef antes
+
+  return lo;
+}
+
+/**
+ * @brief Combina los tramos consecutivos a[0, la) y a[la, la+lb), con 
+ * la <= lb, copiando el primero a taux y combinando hacia delante. Cuando 
+ * un tramo gana TIM_MIN_GALLOP veces seguidas se pasa a copiar bloques 
+ * enteros localizados con gallop
+ * 
+ * @param a la tabla
+ * @param la tamaño del primer tramo
+ * @param lb tamaño del segundo tramo
+ * @param taux tabla auxiliar de al menos la elementos
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) realizadas
+*/
+static int tim_merge_lo(int* a, int la, int lb, int* taux) {
+  int *dest, *pa, *pb;
+  int cuenta_a, cuenta_b, k, n_obs;
+
+  memcpy(taux, a, sizeof(a[0]) * la);
+  dest = a;
+  pa = taux;
+  pb = a+la;
+  n_obs = 0;
+
+  while(la > 0 && lb > 0) {
+    cuenta_a = cuenta_b = 0;
+    while(la > 0 && lb > 0 && cuenta_a < TIM_MIN_GALLOP && cuenta_b < TIM_MIN_GALLOP) {
+      n_obs++;
+      if(*pb < *pa) {
+        *dest++ = *pb++;
+        lb--;
+        cuenta_b++;
+        cuenta_a = 0;
+      }
+      else {
+        *dest++ = *pa++;
+        la--;
+        cuenta_a++;
+        cuenta_b = 0;
+      }
+    }
+
+    while(la > 0 && lb > 0) {
+      k = gallop(*pb, pa, la, 1, 0, &n_obs);
+      memcpy(dest, pa, sizeof(a[0]) * k);
+      dest += k;
+      pa += k;
+      la -= k;
+      if(la == 0) break;
+      *dest++ = *pb++;
+      lb--;
+      if(lb == 0) break;
+
+      cuenta_b = gallop(*pa, pb, lb, 0, 0, &n_obs);
+      memmove(dest, pb, sizeof(a[0]) * cuenta_b);
+      dest += cuenta_b;
+      pb += cuenta_b;
+      lb -= cuenta_b;
+      if(lb == 0) break;
+      *dest++ = *pa++;
+      la--;
+
+      if(k < TIM_MIN_GALLOP && cuenta_b < TIM_MIN_GALLOP) break;
+    }
+  }
+
+  /* Lo que queda del segundo tramo ya está en su sitio */
+  memcpy(dest, pa, sizeof(a[0]) * la);
+
+  return n_obs;
+}
+
+/**
+ * @brief Combina los tramos consecutivos a[0, la) y a[la, la+lb), con 
+ * lb < la, copiando el segundo a taux y combinando hacia atrás
+ * 
+ * @param a la tabla
+ * @param la tamaño del primer tramo
+ * @param lb tamaño del segundo tramo
+ * @param taux tabla auxiliar de al menos lb elementos
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) realizadas
+*/
+static int tim_merge_hi(int* a, int la, int lb, int* taux) {
+  int *dest, *pa, *pb;
+  int cuenta_a, cuenta_b, k, n_obs;
+
+  memcpy(taux, a+la, sizeof(a[0]) * lb);
+  dest = a+la+lb-1;
+  pa = a+la-1;
+  pb = taux+lb-1;
+  n_obs = 0;
+
+  while(la > 0 && lb > 0) {
+    cuenta_a = cuenta_b = 0;
+    while(la > 0 && lb > 0 && cuenta_a < TIM_MIN_GALLOP && cuenta_b < TIM_MIN_GALLOP) {
+      n_obs++;
+      if(*pb < *pa) {
+        *dest-- = *pa--;
+        la--;
+        cuenta_a++;
+        cuenta_b = 0;
+      }
+      else {
+        *dest-- = *pb--;
+        lb--;
+        cuenta_b++;
+        cuenta_a = 0;
+      }
+    }
+
+    while(la > 0 && lb > 0) {
+      /* Elementos del primer tramo mayores que el último del segundo */
+      k = la - gallop(*pb, a, la, 1, 1, &n_obs);
+      dest -= k;
+      pa -= k;
+      la -= k;
+      memmove(dest+1, pa+1, sizeof(a[0]) * k);
+      if(la == 0) break;
+      *dest-- = *pb--;
+      lb--;
+      if(lb == 0) break;
+
+      /* Elementos del segundo tramo mayores o iguales que el último del primero */
+      cuenta_b = lb - gallop(*pa, taux, lb, 0, 1, &n_obs);
+      dest -= cuenta_b;
+      pb -= cuenta_b;
+      lb -= cuenta_b;
+      memcpy(dest+1, pb+1, sizeof(a[0]) * cuenta_b);
+      if(lb == 0) break;
+      *dest-- = *pa--;
+      la--;
+
+      if(k < TIM_MIN_GALLOP && cuenta_b < TIM_MIN_GALLOP) break;
+    }
+  }
+
+  /* Lo que queda del primer tramo ya está en su sitio */
+  memcpy(dest-lb+1, taux, sizeof(a[0]) * lb);
+
+  return n_obs;
+}
+
+/**
+ * @brief Combina los tramos i e i+1 de la pila de timsort. Antes se 
+ * descartan con gallop los elementos del principio del primero y del 
+ * final del segundo que ya están en su sitio
+ * 
+ * @param a la tabla
+ * @param base primera posición de cada tramo de la pila
+ * @param len tamaño de cada tramo de la pila
+ * @param n_runs número de tramos de la pila
+ * @param i posición en la pila del primer tramo a combinar
+ * @param taux tabla auxiliar
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) realizadas
+*/
+static int tim_merge_at(int* a, int* base, int* len, int *n_runs, int i, int* taux) {
+  int *pa, *pb;
+  int la, lb, k, n_obs;
+
+  pa = a + base[i];
+  la = len[i];
+  pb = a + base[i+1];
+  lb = len[i+1];
+
+  len[i] = la+lb;
+  if(i == *n_runs-3) {
+    base[i+1] = base[i+2];
+    len[i+1] = len[i+2];
+  }
+  (*n_runs)--;
+
+  n_obs = 0;
+  k = gallop(pb[0], pa, la, 1, 0, &n_obs);
+  pa += k;
+  la -= k;
+  if(la == 0) return n_obs;
+
+  lb = gallop(pa[la-1], pb, lb, 0, 1, &n_obs);
+  if(lb == 0) return n_obs;
+
+  if(la <= lb) n_obs += tim_merge_lo(pa, la, lb, taux);
+  else n_obs += tim_merge_hi(pa, la, lb, taux);
+
+  return n_obs;
+}
+
+/**
+ * @brief Ordena de menor a mayor una tabla con un mergesort natural al 
+ * estilo de TimSort: detecta los tramos ya ordenados (dando la vuelta a 
+ * los descendentes), alarga los cortos hasta minrun con inserción binaria 
+ * y los combina manteniendo los invariantes de la pila de TimSort con 
+ * combinaciones que galopan. Una tabla ordenada cuesta N-1 comparaciones
+ * 
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int timsort(int* tabla, int ip, int iu) {
+  int base[TIM_STACK], len[TIM_STACK];
+  int *a, *taux;
+  int n, resto, minrun, r, lo, hi, i, j, m, x, k, n_runs, n_obs;
+
+  if(tabla == NULL || ip > iu) return ERR;
+
+  a = &tabla[ip];
+  n = iu-ip+1;
+  if(n < 2) return 0;
+
+  for(resto = 0, minrun = n; minrun >= 64; minrun >>= 1) resto |= minrun & 1;
+  minrun += resto;
+
+  taux = (int*)malloc(sizeof(taux[0]) * (n/2+1));
+  if(taux == NULL) return ERR;
+
+  n_obs = 0;
+  n_runs = 0;
+  for(lo = 0; lo < n; lo = hi) {
+    /* Tramo ascendente o estrictamente descendente a partir de lo */
+    hi = lo+1;
+    if(hi < n) {
+      n_obs++;
+      if(a[hi] < a[lo]) {
+        for(hi++; hi < n; hi++) {
+          n_obs++;
+          if(!(a[hi] < a[hi-1])) break;
+        }
+        for(i = lo, j = hi-1; i < j; i++, j--) {
+          x = a[i];
+          a[i] = a[j];
+          a[j] = x;
+        }
+      }
+      else {
+        for(hi++; hi < n; hi++) {
+          n_obs++;
+          if(a[hi] < a[hi-1]) break;
+        }
+      }
+    }
+
+    /* Los tramos cortos se alargan con inserción binaria */
+    if(hi-lo < minrun) {
+      r = (lo+minrun < n) ? lo+minrun : n;
+      for(; hi < r; hi++) {
+        x = a[hi];
+        i = lo;
+        j = hi;
+        while(i < j) {
+          m = (i+j)/2;
+          n_obs++;
+          if(x < a[m]) j = m;
+          else i = m+1;
+        }
+        memmove(&a[i+1], &a[i], sizeof(a[0]) * (hi-i));
+        a[i] = x;
+      }
+    }
+
+    base[n_runs] = lo;
+    len[n_runs] = hi-lo;
+    n_runs++;
+
+    /* Invariantes: len[k-1] > len[k] + len[k+1] y len[k] > len[k+1] */
+    while(n_runs > 1) {
+      k = n_runs-2;
+      if((k > 0 && len[k-1] <= len[k] + len[k+1]) || 
+         (k > 1 && len[k-2] <= len[k-1] + len[k])) {
+        if(len[k-1] < len[k+1]) k--;
+      }
+      else if(len[k] > len[k+1]) {
+        break;
+      }
+      n_obs += tim_merge_at(a, base, len, &n_runs, k, taux);
+    }
+  }
+
+  while(n_runs > 1) {
+    k = n_runs-2;
+    if(k > 0 && len[k-1] < len[k+1]) k--;
+    n_obs += tim_merge_at(a, base, len, &n_runs, k, taux);
+  }
+
+  free(taux);
+  return n_obs;
+}
+
+/**
+ * @brief Ordena de menor a mayor una tabla con radix sort LSD de 
+ * RADIX_BITS bits por dígito. Los histogramas de todos los dígitos se 
+ * calculan en un único recorrido y se omiten las pasadas en las que 
+ * todas las claves comparten el dígito. Usa una única tabla auxiliar
+ * 
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * 
+ * @return el número de operaciones básicas (movimientos de clave) que ha realizado el algortimo
+*/
+int radixsort(int* tabla, int ip, int iu) {
+  int hist[RADIX_PASSES][RADIX_SIZE];
+  int i, d, n, n_obs, acum, tmp;
+  unsigned int clave;
+  int *taux, *src, *dst, *t;
+
+  if(tabla == NULL || ip > iu) return ERR;
+
+  n = iu-ip+1;
+  src = &tabla[ip];
+
+  memset(hist, 0, sizeof(hist));
+  for(i = 0; i < n; i++) {
+    /* Invertir el bit de signo ordena los negativos antes que los positivos */
+    clave = (unsigned int)src[i] ^ RADIX_SIGN;
+    for(d = 0; d < RADIX_PASSES; d++) {
+      hist[d][(clave >> (d*RADIX_BITS)) & (RADIX_SIZE-1)]++;
+    }
+  }
+
+  taux = (int*)malloc(sizeof(taux[0]) * n);
+  if(taux == NULL) return ERR;
+
+  n_obs = 0;
+  dst = taux;
+  for(d = 0; d < RADIX_PASSES; d++) {
+    clave = ((unsigned int)src[0] ^ RADIX_SIGN) >> (d*RADIX_BITS);
+    if(hist[d][clave & (RADIX_SIZE-1)] == n) continue;
+
+    /* Posición inicial de cada valor del dígito */
+    for(i = 0, acum = 0; i < RADIX_SIZE; i++) {
+      tmp = hist[d][i];
+      hist[d][i] = acum;
+      acum += tmp;
+    }
+
+    for(i = 0; i < n; i++) {
+      clave = ((unsigned int)src[i] ^ RADIX_SIGN) >> (d*RADIX_BITS);
+      dst[hist[d][clave & (RADIX_SIZE-1)]++] = src[i];
+    }
+    n_obs += n;
+
+    t = src;
+    src = dst;
+    dst = t;
+  }
+
+  if(src != &tabla[ip]) {
+    memcpy(&tabla[ip], src, sizeof(tabla[0]) * n);
+  }
+
+  free(taux);
+  return n_obs;
+}
+
+/**
+ * @brief Paso recursivo de mergesort_kv. Combina de forma estable: con 
+ * claves iguales va primero la del primer tramo
+ * 
+ * @param claves la tabla de claves
+ * @param valores la tabla de valores, que se mueve igual que claves
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param caux tabla auxiliar de claves de al menos iu-ip+1 elementos
+ * @param vaux tabla auxiliar de valores de al menos iu-ip+1 elementos
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) realizadas
+*/
+static int mergesort_kv_rec(int* claves, int* valores, int ip, int iu, int* caux, int* vaux) {
+  int medio, i, j, k, n, n_obs;
+
+  if(ip >= iu) return 0;
+
+  medio = (ip+iu)/2;
+  n_obs = mergesort_kv_rec(claves, valores, ip, medio, caux, vaux);
+  n_obs += mergesort_kv_rec(claves, valores, medio+1, iu, caux, vaux);
+
+  for(i = ip, j = medio+1, k = 0; i <= medio && j <= iu; k++) {
+    n_obs++;
+    if(claves[j] < claves[i]) {
+      caux[k] = claves[j];
+      vaux[k] = valores[j++];
+    }
+    else {
+      caux[k] = claves[i];
+      vaux[k] = valores[i++];
+    }
+  }
+  /* Lo que queda del segundo tramo ya está en su sitio */
+  n = medio-i+1;
+  memcpy(&caux[k], &claves[i], sizeof(claves[0]) * n);
+  memcpy(&vaux[k], &valores[i], sizeof(valores[0]) * n);
+  k += n;
+
+  memcpy(&claves[ip], caux, sizeof(claves[0]) * k);
+  memcpy(&valores[ip], vaux, sizeof(valores[0]) * k);
+
+  return n_obs;
+}
+
+/**
+ * @brief Ordena de menor a mayor una tabla de claves con mergesort 
+ * estable, moviendo a la vez una tabla paralela de valores (estructura 
+ * de tablas: las comparaciones sólo recorren las claves)
+ * 
+ * @param claves la tabla de claves
+ * @param valores la tabla de valores, indexada igual que claves
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int mergesort_kv(int* claves, int* valores, int ip, int iu) {
+  int *caux, *vaux;
+  int n_obs;
+
+  if(claves == NULL || valores == NULL || ip > iu) return ERR;
+
+  caux = (int*)malloc(sizeof(caux[0]) * (iu+1-ip));
+  vaux = (int*)malloc(sizeof(vaux[0]) * (iu+1-ip));
+  if(caux == NULL || vaux == NULL) {
+    free(caux);
+    free(vaux);
+    return ERR;
+  }
+
+  n_obs = mergesort_kv_rec(claves, valores, ip, iu, caux, vaux);
+
+  free(caux);
+  free(vaux);
+  return n_obs;
+}
+
+/**
+ * @brief Ordena de menor a mayor una tabla de claves con quicksort 
+ * (mismo pivote y partición que quicksort), moviendo a la vez una tabla 
+ * paralela de valores
+ * 
+ * @param claves la tabla de claves
+ * @param valores la tabla de valores, indexada igual que claves
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * 
+ * @return el número de operaciones básicas realizadas
+*/
+int quicksort_kv(int* claves, int* valores, int ip, int iu) {
+  int i, k, v, x, pos, n_obs, st;
+
+  if(claves == NULL || valores == NULL || ip > iu) return ERR;
+  if(ip == iu) return 0;
+
+  median_stat(claves, ip, iu, &pos);
+
+  k = claves[pos];
+  v = valores[pos];
+  claves[pos] = claves[ip];
+  valores[pos] = valores[ip];
+  pos = ip;
+
+  n_obs = 0;
+  for(i = ip+1; i <= iu; i++) {
+    n_obs++;
+    if(claves[i] < k) {
+      pos++;
+      swap(&claves[i], &claves[pos]);
+      x = valores[i];
+      valores[i] = valores[pos];
+      valores[pos] = x;
+    }
+  }
+
+  claves[ip] = claves[pos];
+  valores[ip] = valores[pos];
+  claves[pos] = k;
+  valores[pos] = v;
+
+  if(ip < pos-1) {
+    st = quicksort_kv(claves, valores, ip, pos-1);
+    if(st == ERR) return ERR;
+    n_obs += st;
+  }
+  if(pos+1 < iu) {
+    st = quicksort_kv(claves, valores, pos+1, iu);
+    if(st == ERR) return ERR;
+    n_obs += st;
+  }
+
+  return n_obs;
+}
+
+/**
+ * @brief Calcula la permutación que ordena una tabla sin modificarla: 
+ * perm[ip+r] es la posición original del elemento r-ésimo más pequeño. 
+ * Ordena una copia de las claves con el método dado usando los índices 
+ * como valores
+ * 
+ * @param tabla la tabla de claves, que no se modifica
+ * @param perm tabla donde se devuelve la permutación, indexada igual que tabla
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param method mergesort_kv (empates en orden de posición) o quicksort_kv
+ * 
+ * @return el número de operaciones básicas del método o ERR
+*/
+static int argsort(int* tabla, int* perm, int ip, int iu, pfunc_sort_kv method) {
+  int *claves;
+  int i, n_obs;
+
+  if(tabla == NULL || perm == NULL || ip > iu) return ERR;
+
+  claves = (int*)malloc(sizeof(claves[0]) * (iu+1-ip));
+  if(claves == NULL) return ERR;
+
+  memcpy(claves, &tabla[ip], sizeof(claves[0]) * (iu+1-ip));
+  for(i = ip; i <= iu; i++) perm[i] = i;
+
+  /* claves[0] corresponde a perm[ip] */
+  n_obs = method(claves, &perm[ip], 0, iu-ip);
+
+  free(claves);
+  return n_obs;
+}
+
+/**
+ * @brief Calcula con mergesort_kv la permutación estable que ordena una 
+ * tabla, sin modificarla
+ * 
+ * @param tabla la tabla de claves
+ * @param perm tabla donde se devuelve la permutación, indexada igual que tabla
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int argsort_merge(int* tabla, int* perm, int ip, int iu) {
+  return argsort(tabla, perm, ip, iu, mergesort_kv);
+}
+
+/**
+ * @brief Calcula con quicksort_kv la permutación que ordena una tabla, 
+ * sin modificarla
+ * 
+ * @param tabla la tabla de claves
+ * @param perm tabla donde se devuelve la permutación, indexada igual que tabla
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * 
+ * @return el número de operaciones básicas realizadas
+*/
+int argsort_quick(int* tabla, int* perm, int ip, int iu) {
+  return argsort(tabla, perm, ip, iu, quicksort_kv);
+}
+
+/**
+ * @brief Hunde el elemento i de un montículo de máximos d-ario de n 
+ * elementos. Los hijos del nodo j son d*j+1, ..., d*j+d, de modo que los 
+ * niveles quedan consecutivos en memoria (orden de anchura); mientras se 
+ * comparan los hijos se pide a la caché el primer nieto
+ * 
+ * @param heap el montículo, indexado desde 0
+ * @param i posición del elemento a hundir
+ * @param n número de elementos del montículo
+ * @param d aridad del montículo
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) realizadas
+*/
+static int heap_sift(int *heap, int i, int n, int d) {
+  int hijo, c, cfin, k, n_obs;
+
+  n_obs = 0;
+  k = heap[i];
+  while((hijo = d*i+1) < n) {
+    if(d*hijo+1 < n) PREFETCH(&heap[d*hijo+1]);
+
+    cfin = (hijo+d < n) ? hijo+d : n;
+    for(c = hijo+1; c < cfin; c++) {
+      n_obs++;
+      if(heap[hijo] < heap[c]) hijo = c;
+    }
+    n_obs++;
+    if(heap[hijo] <= k) break;
+    heap[i] = heap[hijo];
+    i = hijo;
+  }
+  heap[i] = k;
+
+  return n_obs;
+}
+
+/**
+ * @brief Ordena de menor a mayor una tabla con heapsort sobre un montículo 
+ * d-ario construido en la propia tabla, sin memoria auxiliar
+ * 
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param d aridad del montículo (al menos 2)
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int heapsort_d(int* tabla, int ip, int iu, int d) {
+  int i, n, n_obs;
+  int *heap;
+
+  if(tabla == NULL || ip > iu || d < 2) return ERR;
+
+  heap = &tabla[ip];
+  n = iu-ip+1;
+  n_obs = 0;
+
+  for(i = (n-2)/d; i >= 0; i--) {
+    n_obs += heap_sift(heap, i, n, d);
+  }
+  for(i = n-1; i > 0; i--) {
+    swap(&heap[0], &heap[i]);
+    n_obs += heap_sift(heap, 0, i, d);
+  }
+
+  return n_obs;
+}
+
+/**
+ * @brief Ordena de menor a mayor una tabla con heapsort binario
+ * 
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int heapsort(int* tabla, int ip, int iu) {
+  return heapsort_d(tabla, ip, iu, 2);
+}
+
+/**
+ * @brief Ordena de menor a mayor una tabla con heapsort 4-ario: la mitad 
+ * de niveles que el binario y los cuatro hijos en la misma línea de caché
+ * 
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int heapsort4(int* tabla, int ip, int iu) {
+  return heapsort_d(tabla, ip, iu, 4);
+}
+
+/**
+ * @brief Añade un elemento de un flujo al montículo de máximos con los k 
+ * menores elementos vistos hasta ahora. Mientras no está lleno el 
+ * elemento sube desde la última posición; después sólo entra si es menor 
+ * que la raíz, a la que sustituye
+ * 
+ * @param heap el montículo, con espacio para k elementos
+ * @param n_heap número de elementos del montículo, que se actualiza
+ * @param k número de elementos que se conservan
+ * @param x el elemento a añadir
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) realizadas
+*/
+int topk_push(int* heap, int *n_heap, int k, int x) {
+  int i, padre, n_obs;
+
+  if(heap == NULL || n_heap == NULL || k < 1 || *n_heap > k) return ERR;
+
+  n_obs = 0;
+  if(*n_heap < k) {
+    i = (*n_heap)++;
+    while(i > 0) {
+      padre = (i-1)/2;
+      n_obs++;
+      if(x <= heap[padre]) break;
+      heap[i] = heap[padre];
+      i = padre;
+    }
+    heap[i] = x;
+    return n_obs;
+  }
+
+  n_obs++;
+  if(x < heap[0]) {
+    heap[0] = x;
+    n_obs += heap_sift(heap, 0, k, 2);
+  }
+
+  return n_obs;
+}
+
+/**
+ * @brief Ordena de menor a mayor el montículo de topk_push sin memoria 
+ * auxiliar, extrayendo la raíz al final como heapsort
+ * 
+ * @param heap el montículo
+ * @param n_heap número de elementos del montículo
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) realizadas
+*/
+int topk_sort(int* heap, int n_heap) {
+  int i, n_obs;
+
+  if(heap == NULL || n_heap < 0) return ERR;
+
+  n_obs = 0;
+  for(i = n_heap-1; i > 0; i--) {
+    swap(&heap[0], &heap[i]);
+    n_obs += heap_sift(heap, 0, i, 2);
+  }
+
+  return n_obs;
+}
+
+/**
+ * @brief Devuelve ordenados los k menores elementos de la tabla sin 
+ * modificarla, recorriéndola una vez como un flujo con topk_push. Usa 
+ * O(k) memoria y O(N log k) comparaciones
+ * 
+ * @param tabla la tabla
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param salida tabla de al menos k elementos donde se devuelven
+ * @param k número de elementos a devolver, entre 1 e iu-ip+1
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int topk_heap(int* tabla, int ip, int iu, int* salida, int k) {
+  int i, n_heap, n_obs;
+
+  if(tabla == NULL || salida == NULL || ip > iu || k < 1 || k > iu-ip+1) return ERR;
+
+  n_heap = 0;
+  n_obs = 0;
+  for(i = ip; i <= iu; i++) {
+    n_obs += topk_push(salida, &n_heap, k, tabla[i]);
+  }
+
+  return n_obs + topk_sort(salida, n_heap);
+}
+
+/**
+ * @brief Ordena la tabla con quicksort recurriendo sólo sobre la 
+ * subtabla más pequeña e iterando sobre la mayor, de modo que la 
+ * profundidad de recursión es como mucho log2(N). Realiza las mismas 
+ * particiones y operaciones básicas que quicksort
+ * 
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * 
+ * @return el número de operaciones básicas realizadas
+*/
+int quicksort_tail(int* tabla, int ip, int iu) {
+  int pos;
+  int n_obs, st;
+
+  if(ip>iu) return ERR;
+
+  n_obs = 0;
+  while(ip < iu) {
+    if(iu-ip+1 <= net_cutoff) return n_obs + sortnet(tabla, ip, iu);
+
+    st = partition(tabla, ip, iu, &pos);
+    if(st == ERR) return ERR;
+    n_obs += st;
+
+    if(pos-ip < iu-pos) {
+      if(ip < pos-1) {
+        st = quicksort_tail(tabla, ip, pos-1);
+        if(st == ERR) return ERR;
+        n_obs += st;
+      }
+      ip = pos+1;
+    }
+    else {
+      if((pos+1) < iu) {
+        st = quicksort_tail(tabla, pos+1, iu);
+        if(st == ERR) return ERR;
+        n_obs += st;
+      }
+      iu = pos-1;
+    }
+  }
+
+  return n_obs;
+}
+
+/* estado compartido de quicksort_par_n */
+typedef struct {
+  int *tabla;
+  int *n_obs;    /* contador de cada hilo, separados PAR_PAD posiciones */
+  long *n_swaps; /* intercambios de cada hilo, separados PAR_PAD posiciones */
+  int error;
+} QSORT_PAR;
+
+/**
+ * @brief Tarea de quicksort_par_n: particiona el tramo, añade la parte 
+ * menor como tarea que se puede robar y sigue con la mayor hasta bajar 
+ * de PAR_CUTOFF elementos, que ordena con quicksort
+ * 
+ * @param ws el planificador
+ * @param id número del hilo que ejecuta la tarea
+ * @param ip primer elemento del tramo
+ * @param iu último elemento del tramo
+ * @param arg puntero a QSORT_PAR
+*/
+static void quicksort_par_task(PWS ws, int id, int ip, int iu, void *arg) {
+  QSORT_PAR *q = (QSORT_PAR*)arg;
+  int pos, n_obs, st;
+  long n_swaps;
+
+  n_obs = 0;
+  n_swaps = swap_count();
+  while(iu-ip+1 > PAR_CUTOFF) {
+    st = partition(q->tabla, ip, iu, &pos);
+    if(st == ERR) {
+      q->error = 1;
+      return;
+    }
+    n_obs += st;
+
+    if(pos-ip < iu-pos) {
+      if(ws_push(ws, id, ip, pos-1) == ERR) q->error = 1;
+      ip = pos+1;
+    }
+    else {
+      if(ws_push(ws, id, pos+1, iu) == ERR) q->error = 1;
+      iu = pos-1;
+    }
+  }
+
+  if(ip < iu) {
+    st = quicksort(q->tabla, ip, iu);
+    if(st == ERR) q->error = 1;
+    else n_obs += st;
+  }
+
+  /* Cada hilo sólo escribe en su contador */
+  q->n_obs[id*PAR_PAD] += n_obs;
+  q->n_swaps[id*PAR_PAD] += swap_count() - n_swaps;
+}
+
+/**
+ * @brief Ordena la tabla con quicksort en paralelo usando n_threads hilos 
+ * con robo de trabajo. Cada partición deja la parte menor en la cola del 
+ * hilo para que otro hilo pueda robarla. Cuenta las mismas operaciones 
+ * básicas que quicksort
+ * 
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param n_threads número de hilos
+ * 
+ * @return el número de operaciones básicas realizadas
+*/
+int quicksort_par_n(int* tabla, int ip, int iu, int n_threads) {
+  QSORT_PAR q;
+  int i, n_obs;
+
+  if(tabla == NULL || ip > iu || n_threads < 1) return ERR;
+
+  if(n_threads == 1 || iu-ip+1 <= PAR_CUTOFF) return quicksort(tabla, ip, iu);
+
+  q.tabla = tabla;
+  q.error = 0;
+  q.n_obs = (int*)calloc(n_threads * PAR_PAD, sizeof(q.n_obs[0]));
+  q.n_swaps = (long*)calloc(n_threads * PAR_PAD, sizeof(q.n_swaps[0]));
+  if(q.n_obs == NULL || q.n_swaps == NULL) {
+    free(q.n_obs);
+    free(q.n_swaps);
+    return ERR;
+  }
+
+  if(ws_run(n_threads, quicksort_par_task, &q, ip, iu) == ERR || q.error) {
+    free(q.n_obs);
+    free(q.n_swaps);
+    return ERR;
+  }
+
+  /* El hilo 0 es el llamante, que ya tiene sus intercambios contados */
+  for(i = 0, n_obs = 0; i < n_threads; i++) {
+    n_obs += q.n_obs[i*PAR_PAD];
+    if(i > 0) add_swap_count(q.n_swaps[i*PAR_PAD]);
+  }
+
+  free(q.n_obs);
+  free(q.n_swaps);
+  return n_obs;
+}
+
+/**
+ * @brief Ordena la tabla con quicksort en paralelo usando todos los 
+ * procesadores disponibles
+ * 
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * 
+ * @return el número de operaciones básicas realizadas
+*/
+int quicksort_par(int* tabla, int ip, int iu) {
+  return quicksort_par_n(tabla, ip, iu, pool_default_threads());
+}
+
+/**
+ * @brief Paso recursivo de introsort
+ * 
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param depth número de niveles de recursión restantes antes de 
+ * recurrir a heapsort
+ * 
+ * @return el número de operaciones básicas realizadas
+*/
+static int introsort_rec(int* tabla, int ip, int iu, int depth) {
+  int pos, n_obs, st;
+
+  if(ip >= iu) return 0;
+  if(iu-ip+1 <= INTRO_CUTOFF) return InsertSort(tabla, ip, iu);
+  if(depth == 0) return heapsort(tabla, ip, iu);
+
+  n_obs = partition_pivot(tabla, ip, iu, &pos, median_stat);
+  if(n_obs == ERR) return ERR;
+
+  st = introsort_rec(tabla, ip, pos-1, depth-1);
+  if(st == ERR) return ERR;
+  n_obs += st;
+
+  st = introsort_rec(tabla, pos+1, iu, depth-1);
+  if(st == ERR) return ERR;
+  n_obs += st;
+
+  return n_obs;
+}
+
+/**
+ * @brief Ordena la tabla con introsort: quicksort con pivote median_stat 
+ * que pasa a heapsort cuando la recursión supera 2*log2(N) niveles y 
+ * ordena por inserción los tramos de INTRO_CUTOFF elementos o menos
+ * 
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * 
+ * @return el número de operaciones básicas realizadas
+*/
+int introsort(int* tabla, int ip, int iu) {
+  int n, depth;
+
+  if(tabla == NULL || ip > iu) return ERR;
+
+  for(n = iu-ip+1, depth = 0; n > 1; n /= 2) depth += 2;
+
+  return introsort_rec(tabla, ip, iu, depth);
+}
+
+/**
+ * @brief Elige como pivote la mediana de las medianas de grupos de 
+ * MOM_GROUP elementos. Ordena cada grupo por inserción, lleva su mediana 
+ * al principio de la tabla y selecciona la mediana de esas medianas con 
+ * select_rec, también por mediana de medianas, de modo que el pivote deja 
+ * al menos 3/10 de la tabla a cada lado
+ * 
+ * @param tabla la tabla
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param pos posición del pivote elegido
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) realizadas
+*/
+static int median_mom(int* tabla, int ip, int iu, int *pos) {
+  int i, gu, g, n_obs;
+
+  n_obs = 0;
+  for(i = ip, g = ip; i <= iu; i += MOM_GROUP, g++) {
+    gu = (i+MOM_GROUP-1 < iu) ? i+MOM_GROUP-1 : iu;
+    n_obs += InsertSort(tabla, i, gu);
+    swap(&tabla[g], &tabla[(i+gu)/2]);
+  }
+
+  *pos = ip + (g-1-ip)/2;
+  return n_obs + select_rec(tabla, ip, g-1, *pos, 1);
+}
+
+/**
+ * @brief Paso de quickselect: parte en tres (menores, iguales y mayores 
+ * que el pivote) quedándose sólo con el lado que contiene k, de modo que 
+ * las claves iguales al pivote se descartan de una vez. El pivote es el 
+ * de median_stat, salvo cuando dos particiones seguidas no han reducido 
+ * el tramo a la mitad (regla de Musser): entonces la siguiente lo elige 
+ * con median_mom, que deja como mucho 7/10 del tramo. Como ninguna 
+ * partición agranda el tramo, el tiempo es lineal incluso con claves 
+ * repetidas
+ * 
+ * @param tabla la tabla
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param k posición que se quiere colocar
+ * @param mom 1 para elegir siempre el pivote con median_mom
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) realizadas
+*/
+static int select_rec(int* tabla, int ip, int iu, int k, int mom) {
+  int pos, lt, gt, n, n_ant, usa_mom, fallo, n_obs;
+
+  n_obs = 0;
+  n = iu-ip;
+  n_ant = -1;
+  usa_mom = mom;
+  while(ip < iu) {
+    if(iu-ip+1 <= INTRO_CUTOFF) return n_obs + InsertSort(tabla, ip, iu);
+
+    pos = ip;
+    if(usa_mom) n_obs += median_mom(tabla, ip, iu, &pos);
+    else median_stat(tabla, ip, iu, &pos);
+    n_obs += partition3_at(tabla, ip, iu, pos, &lt, &gt);
+
+    if(k < lt) iu = lt-1;
+    else if(k > gt) ip = gt+1;
+    else break;
+
+    /* n_ant es el tamaño antes de la partición anterior, o -1 si ésta 
+       es la primera desde el principio o desde la última con median_mom */
+    fallo = (n_ant >= 0 && iu-ip > n_ant/2);
+    n_ant = usa_mom ? -1 : n;
+    n = iu-ip;
+    usa_mom = mom || fallo;
+  }
+
+  return n_obs;
+}
+
+/**
+ * @brief Coloca en la posición k el elemento que quedaría en ella si se 
+ * ordenase la tabla, con los menores o iguales delante y los mayores o 
+ * iguales detrás (nth_element). Usa introselect: quickselect con 
+ * partición en tres que pasa a mediana de medianas cuando las 
+ * particiones dejan de reducir el tramo a la mitad (ver select_rec)
+ * 
+ * @param tabla la tabla
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param k posición a colocar, entre ip e iu
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int quickselect(int* tabla, int ip, int iu, int k) {
+  if(tabla == NULL || ip > iu || k < ip || k > iu) return ERR;
+
+  return select_rec(tabla, ip, iu, k, 0);
+}
+
+/**
+ * @brief Deja ordenados en [ip, ip+k-1] los k menores elementos de la 
+ * tabla; el resto queda detrás en cualquier orden. Selecciona el k-ésimo 
+ * con quickselect y ordena los anteriores con introsort
+ * 
+ * @param tabla la tabla
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param k número de elementos a ordenar, entre 0 e iu-ip+1
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int partial_sort(int* tabla, int ip, int iu, int k) {
+  int n_obs, st;
+
+  if(tabla == NULL || ip > iu || k < 0 || k > iu-ip+1) return ERR;
+  if(k == 0) return 0;
+
+  n_obs = quickselect(tabla, ip, iu, ip+k-1);
+  if(n_obs == ERR) return ERR;
+
+  if(k > 1) {
+    st = introsort(tabla, ip, ip+k-2);
+    if(st == ERR) return ERR;
+    n_obs += st;
+  }
+
+  return n_obs;
+}
+
+/**
+ * @brief Ordena la tabla con quicksort usando la partición de Hoare
+ * 
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * 
+ * @return el número de operaciones básicas realizadas
+*/
+int quicksort_hoare(int* tabla, int ip, int iu) {
+  int pos;
+  int n_obs, st;
+
+  if(ip>iu) return ERR;
+  if(ip==iu) return 0;
+
+  n_obs = partition_hoare(tabla, ip, iu, &pos);
+  if(n_obs == ERR) return ERR;
+
+  if(ip < pos) {
+    st = quicksort_hoare(tabla, ip, pos);
+    if(st == ERR) return ERR;
+    n_obs += st;
+  }
+  if((pos+1) < iu) {
+    st = quicksort_hoare(tabla, pos+1, iu);
+    if(st == ERR) return ERR;
+    n_obs += st;
+  }
+
+  return n_obs;
+}
+
+/**
+ * @brief realiza una partición de Hoare: dos índices avanzan desde los 
+ * extremos hacia el centro e intercambian sólo los pares de elementos 
+ * que están en el lado equivocado. A diferencia de partition, el pivote 
+ * no queda necesariamente en su posición final
+ * 
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param pos última posición de la primera subtabla: los elementos de 
+ * [ip, pos] son menores o iguales que los de [pos+1, iu]
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) realizadas
+*/
+int partition_hoare(int* tabla, int ip, int iu, int *pos) {
+  int i, j, k, n_obs;
+
+  if(median_stat(tabla, ip, iu, pos) == ERR) {
+    return ERR;
+  }
+
+  /* Con el pivote en ip la partición nunca devuelve pos == iu */
+  swap(&tabla[ip], &tabla[*pos]);
+  k = tabla[ip];
+
+  n_obs = 0;
+  i = ip-1;
+  j = iu+1;
+  while(1) {
+    do {
+      i++;
+      n_obs++;
+    } while(tabla[i] < k);
+    do {
+      j--;
+      n_obs++;
+    } while(tabla[j] > k);
+
+    if(i >= j) break;
+    swap(&tabla[i], &tabla[j]);
+  }
+
+  *pos = j;
+  return n_obs;
+}
+
+/**
+ * @brief Ordena la tabla con quicksort usando la partición por bloques 
+ * partition_block
+ * 
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * 
+ * @return el número de operaciones básicas realizadas
+*/
+int quicksort_block(int* tabla, int ip, int iu) {
+  int pos;
+  int n_obs, st;
+
+  if(ip>iu) return ERR;
+  if(ip==iu) return 0;
+
+  n_obs = partition_block(tabla, ip, iu, &pos);
+  if(n_obs == ERR) return ERR;
+
+  if(ip < pos-1) {
+    st = quicksort_block(tabla, ip, pos-1);
+    if(st == ERR) return ERR;
+    n_obs += st;
+  }
+  if((pos+1) < iu) {
+    st = quicksort_block(tabla, pos+1, iu);
+    if(st == ERR) return ERR;
+    n_obs += st;
+  }
+
+  return n_obs;
+}
 
 /**
- * @brief Ordena de menor a mayor un array
+ * @brief realiza una partición en dos por bloques (BlockQuicksort). Se 
+ * recorren bloques de BLOCK_SIZE elementos en cada extremo guardando, sin 
+ * saltos condicionales, las posiciones de los elementos que están en el 
+ * lado equivocado; después se intercambian por parejas. El tramo central 
+ * restante se particiona como en partition
  * 
- * @param array el array a ordenar
- * @param ip primer índice del array
- * @param iu último índice del array
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param pos pivote divisiorio sobre el cual se va a ordenar la tabla
  * 
- * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+ * @return el número de operaciones básicas (comparaciones de clave) realizadas
 */
-int SelectSort(int* array, int ip, int iu)
-{
-  int i, count, minimum;
+int partition_block(int* tabla, int ip, int iu, int *pos) {
+  unsigned char off_l[BLOCK_SIZE], off_r[BLOCK_SIZE];
+  int i, l, r, k, m, n_obs;
+  int num_l, num_r, start_l, start_r, num;
 
-  if(array == NULL || ip > iu) return ERR;
+  if(median_stat(tabla, ip, iu, pos) == ERR) {
+    return ERR;
+  }
 
-  count = 0;
-  i = ip;
-  while(i < iu) {
-    minimum = min(array, i, iu);
-    count += iu-i;
-    swap(&array[i], &array[minimum]);
-    i++;
+  swap(&tabla[ip], &tabla[*pos]);
+  k = tabla[ip];
+
+  /* [ip+1, l) <= k, (r, iu] >= k */
+  n_obs = 0;
+  l = ip+1;
+  r = iu;
+  num_l = num_r = start_l = start_r = 0;
+  while(r-l+1 >= 2*BLOCK_SIZE) {
+    if(num_l == 0) {
+      start_l = 0;
+      for(i = 0; i < BLOCK_SIZE; i++) {
+        off_l[num_l] = (unsigned char)i;
+        num_l += (tabla[l+i] >= k);
+      }
+      n_obs += BLOCK_SIZE;
+    }
+    if(num_r == 0) {
+      start_r = 0;
+      for(i = 0; i < BLOCK_SIZE; i++) {
+        off_r[num_r] = (unsigned char)i;
+        num_r += (k >= tabla[r-i]);
+      }
+      n_obs += BLOCK_SIZE;
+    }
+
+    num = (num_l < num_r) ? num_l : num_r;
+    for(i = 0; i < num; i++) {
+      swap(&tabla[l+off_l[start_l+i]], &tabla[r-off_r[start_r+i]]);
+    }
+
+    num_l -= num;
+    num_r -= num;
+    start_l += num;
+    start_r += num;
+    if(num_l == 0) l += BLOCK_SIZE;
+    if(num_r == 0) r -= BLOCK_SIZE;
   }
 
-  return count;
+  /* Tramo central [l, r], incluidos los bloques a medio procesar */
+  m = l;
+  for(i = l; i <= r; i++) {
+    n_obs++;
+    if(tabla[i] < k) {
+      swap(&tabla[i], &tabla[m]);
+      m++;
+    }
+  }
+
+  *pos = m-1;
+  swap(&tabla[ip], &tabla[*pos]);
+
+  return n_obs;
 }
 
+#ifdef SORTING_AVX2
+
+/* permutaciones que agrupan al principio los elementos menores que el 
+   pivote según la máscara de comparación de 8 bits */
+static int avx2_perm[256][8];
+
 /**
- * @brief Ordena de mayor a menor un array
+ * @brief Rellena la tabla avx2_perm
+*/
+static void avx2_init(void) {
+  int mask, i, j;
+
+  for(mask = 0; mask < 256; mask++) {
+    j = 0;
+    for(i = 0; i < 8; i++) {
+      if(mask & (1 << i)) avx2_perm[mask][j++] = i;
+    }
+    for(i = 0; i < 8; i++) {
+      if(!(mask & (1 << i))) avx2_perm[mask][j++] = i;
+    }
+  }
+}
+
+/**
+ * @brief Particiona [l, r) respecto a k con instrucciones AVX2. Se guardan 
+ * aparte el primer y el último vector para tener siempre 16 huecos 
+ * libres; cada vector leído se compacta (menores delante) y se escribe 
+ * a la vez en el hueco izquierdo y en el derecho
  * 
- * @param array el array a ordenar
- * @param ip primer índice del array
- * @param iu último índice del array
+ * @param tabla la tabla a particionar
+ * @param l primer elemento del tramo
+ * @param r posición siguiente al último elemento del tramo (r-l >= 16)
+ * @param k el pivote
  * 
- * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+ * @return la primera posición de los elementos mayores o iguales que k
 */
-int SelectSortInv(int* array, int ip, int iu)
-{
-  int i, count, minimum;
+__attribute__((target("avx2")))
+static int avx2_partition_range(int* tabla, int l, int r, int k) {
+  __m256i vk, v, c, primero, ultimo;
+  int wl, wr, mask, nl, i, n;
+  int resto[24];
 
-  if(array == NULL || ip > iu) return ERR;
+  vk = _mm256_set1_epi32(k);
+  primero = _mm256_loadu_si256((__m256i*)&tabla[l]);
+  ultimo = _mm256_loadu_si256((__m256i*)&tabla[r-8]);
+  wl = l;
+  wr = r;
+  l += 8;
+  r -= 8;
 
-  for(i=0; i<iu; i++);
+  while(r-l >= 8) {
+    /* Se lee del lado con menos huecos libres para no pisar datos */
+    if(l-wl <= wr-r) {
+      v = _mm256_loadu_si256((__m256i*)&tabla[l]);
+      l += 8;
+    }
+    else {
+      r -= 8;
+      v = _mm256_loadu_si256((__m256i*)&tabla[r]);
+    }
+    mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(vk, v)));
+    nl = __builtin_popcount(mask);
+    c = _mm256_permutevar8x32_epi32(v, _mm256_loadu_si256((__m256i*)avx2_perm[mask]));
+    _mm256_storeu_si256((__m256i*)&tabla[wl], c);
+    _mm256_storeu_si256((__m256i*)&tabla[wr-8], c);
+    wl += nl;
+    wr -= 8-nl;
+  }
 
-  count = 0;
-  while(i >= 0) {
-    minimum = min(array, ip, i);
-    count += i-ip;
-    swap(&array[i], &array[minimum]);
-    i--;
+  /* Los dos vectores guardados y los menos de 8 elementos sin leer se 
+     copian antes de escribir, porque ya no quedan huecos a ambos lados */
+  _mm256_storeu_si256((__m256i*)&resto[0], primero);
+  _mm256_storeu_si256((__m256i*)&resto[8], ultimo);
+  for(n = 16; l < r; l++, n++) {
+    resto[n] = tabla[l];
+  }
+  for(i = 0; i < n; i++) {
+    if(resto[i] < k) tabla[wl++] = resto[i];
+    else tabla[--wr] = resto[i];
   }
 
-  return count;
+  return wl;
 }
 
 /**
- * @brief Localiza el menor elemento de un array
+ * @brief realiza una partición en dos con el mismo pivote que partition 
+ * (median_stat, menores a la izquierda) usando avx2_partition_range. El 
+ * pivote queda en la misma posición y se cuentan las mismas operaciones 
+ * básicas, pero el orden de los elementos dentro de cada lado es otro
  * 
- * @param array el array en el que busca
- * @param ip primer índice del array
- * @param iu último índice del array
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param pos pivote divisiorio sobre el cual se va a ordenar la tabla
  * 
- * @return el índice del menor elemento del array
+ * @return el número de operaciones básicas realizadas
 */
-int min(int* array, int ip, int iu)
-{
-  int i;
-  int min;
-  
-  min = ip;
-  for(i = ip+1; i<=iu; i++) {
-    if(array[i] < array[min]) {
-      min = i;
-    }
+static int partition_avx2(int* tabla, int ip, int iu, int *pos) {
+  if(median_stat(tabla, ip, iu, pos) == ERR) {
+    return ERR;
   }
 
-  return min;
+  swap(&tabla[ip], &tabla[*pos]);
+  *pos = avx2_partition_range(tabla, ip+1, iu+1, tabla[ip]) - 1;
+  swap(&tabla[ip], &tabla[*pos]);
+
+  return iu-ip;
+}
+
+#endif
+
+/* nivel SIMD de la CPU, que calcula simd_init una sola vez */
+static int simd_nivel = SIMD_NONE;
+static pthread_once_t simd_once = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Comprueba qué instrucciones SIMD soporta la CPU y prepara las
+ * tablas de la partición AVX2. Se llama con pthread_once, así que los
+ * hilos del pool no pueden verla a medio hacer
+*/
+static void simd_init(void) {
+#ifdef SORTING_AVX2
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("avx2")) {
+    avx2_init();
+    simd_nivel = SIMD_AVX2;
+  }
+  else if(__builtin_cpu_supports("sse4.1")) {
+    simd_nivel = SIMD_SSE41;
+  }
+#endif
+}
+
+/**
+ * @brief Indica qué instrucciones SIMD soporta la CPU, comprobándolo la 
+ * primera vez que se llama desde cualquier hilo
+ * 
+ * @return SIMD_AVX2, SIMD_SSE41 o SIMD_NONE
+*/
+int simd_level(void) {
+  pthread_once(&simd_once, simd_init);
+
+  return simd_nivel;
 }
 
 /**
- * @brief Ordena de menor a mayor una tabla
+ * @brief Indica si se puede usar la partición AVX2
+ * 
+ * @return 1 si la CPU soporta AVX2, 0 en caso contrario
+*/
+int simd_available(void) {
+  return simd_level() == SIMD_AVX2;
+}
+
+/**
+ * @brief realiza una partición en dos con instrucciones AVX2 si la CPU 
+ * las soporta y el tramo tiene al menos SIMD_CUTOFF elementos. En otro 
+ * caso llama a partition. El pivote queda en la misma posición que con 
+ * partition y cada llamada cuenta las mismas operaciones básicas, pero 
+ * los lados quedan en otro orden, por lo que el total de quicksort_simd 
+ * no coincide con el de quicksort
  * 
  * @param tabla la tabla a ordenar
  * @param ip primer elemento de la tabla
  * @param iu último elemento de la tabla
+ * @param pos pivote divisiorio sobre el cual se va a ordenar la tabla
  * 
- * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+ * @return el número de operaciones básicas realizadas
+*/
+int partition_simd(int* tabla, int ip, int iu, int *pos) {
+#ifdef SORTING_AVX2
+  if(tabla != NULL && iu-ip+1 >= SIMD_CUTOFF && simd_available()) {
+    return partition_avx2(tabla, ip, iu, pos);
+  }
+#endif
+  return partition(tabla, ip, iu, pos);
+}
+
+/**
+ * @brief Ordena la tabla con quicksort usando partition_simd
+ * 
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * 
+ * @return el número de operaciones básicas realizadas
 */
-int mergesort(int* tabla, int ip, int iu) {
-  int medio, n_obs, st;
+int quicksort_simd(int* tabla, int ip, int iu) {
+  int pos;
+  int n_obs, st;
+
+  if(ip>iu) return ERR;
+  if(ip==iu) return 0;
 
-  if(ip > iu) return ERR;
+  n_obs = partition_simd(tabla, ip, iu, &pos);
+  if(n_obs == ERR) return ERR;
 
-  /* Caso Base */
-  if(ip == iu) {
-    return OK;
+  if(ip < pos-1) {
+    st = quicksort_simd(tabla, ip, pos-1);
+    if(st == ERR) return ERR;
+    n_obs += st;
+  }
+  if((pos+1) < iu) {
+    st = quicksort_simd(tabla, pos+1, iu);
+    if(st == ERR) return ERR;
+    n_obs += st;
   }
 
-  n_obs = 0;
-  medio = (ip+iu)/2;
-  st = mergesort(tabla, ip, medio);
-  if (st == ERR) return ERR;
-  n_obs += st;
-  st = mergesort(tabla, medio+1, iu);
-  if(st==ERR) return ERR;
-  n_obs += st;
-  
-  n_obs += merge(tabla, ip, iu, medio);
   return n_obs;
 }
 
 /**
- * @brief Combina las dos subtablas en una tabla auxiliar y esta la copia en la tabla original
+ * @brief Ordena la tabla con quicksort de partición en tres (bandera 
+ * holandesa). Las claves iguales al pivote quedan en su posición final 
+ * y sólo se recurre sobre las estrictamente menores y mayores
  * 
  * @param tabla la tabla a ordenar
  * @param ip primer elemento de la tabla
  * @param iu último elemento de la tabla
- * @param imedio valor medio del número de elementos
  * 
- * @return la tabla combinada
+ * @return el número de operaciones básicas realizadas
 */
-int merge(int* tabla, int ip, int iu, int imedio) {
-  int i, j, k, n_obs;
-  int *taux;
+int quicksort3(int* tabla, int ip, int iu) {
+  int lt, gt, n_obs, st;
 
-  taux = (int*)malloc(sizeof(int) * (iu+1-ip));
-  if(taux == NULL) return ERR;
-  n_obs = 0;
+  if(ip>iu) return ERR;
+  if(ip==iu) return 0;
+
+  n_obs = partition3(tabla, ip, iu, &lt, &gt);
+  if(n_obs == ERR) return ERR;
+
+  if(ip < lt-1) {
+    st = quicksort3(tabla, ip, lt-1);
+    if(st == ERR) return ERR;
+    n_obs += st;
+  }
+  if(gt+1 < iu) {
+    st = quicksort3(tabla, gt+1, iu);
+    if(st == ERR) return ERR;
+    n_obs += st;
+  }
+
+  return n_obs;
+}
+
+/**
+ * @brief realiza una partición en tres (menores, iguales y mayores que 
+ * el pivote) con el esquema de Dijkstra
+ * 
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param lt primera posición de las claves iguales al pivote
+ * @param gt última posición de las claves iguales al pivote
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) realizadas
+*/
+int partition3(int* tabla, int ip, int iu, int *lt, int *gt) {
+  int pos;
 
-  for(i = ip, j = imedio+1, k = 0; (i<=imedio) && (j<=iu); k++){
+  if(lt == NULL || gt == NULL || median_stat(tabla, ip, iu, &pos) == ERR) {
+    return ERR;
+  }
+
+  return partition3_at(tabla, ip, iu, pos, lt, gt);
+}
+
+/**
+ * @brief realiza una partición en tres respecto al elemento de la 
+ * posición pos con el esquema de Dijkstra
+ * 
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param pos posición del pivote
+ * @param lt primera posición de las claves iguales al pivote
+ * @param gt última posición de las claves iguales al pivote
+ * 
+ * @return el número de operaciones básicas (comparaciones de clave) realizadas
+*/
+static int partition3_at(int* tabla, int ip, int iu, int pos, int *lt, int *gt) {
+  int i, k, n_obs;
+
+  n_obs = 0;
+  k = tabla[pos];
+  *lt = ip;
+  *gt = iu;
+  i = ip;
+  while(i <= *gt) {
     n_obs++;
-    if (tabla[i] < tabla[j]){
-      taux[k] = tabla[i];
+    if(tabla[i] < k) {
+      swap(&tabla[i], &tabla[*lt]);
+      (*lt)++;
       i++;
+      continue;
     }
-    else {
-      taux[k] = tabla[j];
-      j++;
-    }
-  }
-
-  if(i > imedio) {
-    while (j <= iu) {
-    taux[k] = tabla[j];
-    j++;
-    k++;
+    n_obs++;
+    if(tabla[i] > k) {
+      swap(&tabla[i], &tabla[*gt]);
+      (*gt)--;
     }
-  }
-  else if (j > iu){
-    while (i <= imedio)
-    {
-      taux[k]=tabla[i];
+    else {
       i++;
-      k++;
     }
   }
-  
-  
-  /* Copiar */
-  for(i=ip, j=0; i<=iu; i++, j++) {
-    tabla[i] = taux[j];
-  }
 
-  free(taux);
   return n_obs;
 }
 
-
-
 /**
- * @brief Elige un pivote, que puede ser la media, mediana o el 
- * elemento central y ordena la tabla en función de ese pivote
+ * @brief Ordena la tabla con quicksort usando la partición en tres de 
+ * Bentley y McIlroy
  * 
  * @param tabla la tabla a ordenar
  * @param ip primer elemento de la tabla
  * @param iu último elemento de la tabla
  * 
- * @return la tabla ordenada
+ * @return el número de operaciones básicas realizadas
 */
-int quicksort(int* tabla, int ip, int iu) {  
-  int pos;
-  int n_obs, st;
+int quicksort_bm(int* tabla, int ip, int iu) {
+  int lt, gt, n_obs, st;
 
   if(ip>iu) return ERR;
-  if (ip==iu) return 0;
+  if(ip==iu) return 0;
 
- 
-  n_obs = partition(tabla, ip, iu, &pos);
+  n_obs = partition_bm(tabla, ip, iu, &lt, &gt);
   if(n_obs == ERR) return ERR;
 
-  if (ip < pos-1)
-  {
-    st = quicksort(tabla, ip, pos-1);
+  if(ip < lt-1) {
+    st = quicksort_bm(tabla, ip, lt-1);
     if(st == ERR) return ERR;
     n_obs += st;
   }
-  if ((pos+1) < iu)
-  {
-    st = quicksort(tabla, pos+1, iu);
+  if(gt+1 < iu) {
+    st = quicksort_bm(tabla, gt+1, iu);
     if(st == ERR) return ERR;
     n_obs += st;
   }
@@ -221,45 +3151,65 @@ int quicksort(int* tabla, int ip, int iu) {
 }
 
 /**
- * @brief realiza una partición en dos respecto al total de la tabla
+ * @brief realiza una partición en tres con el esquema de Bentley y 
+ * McIlroy: las claves iguales al pivote se acumulan en los extremos 
+ * durante el recorrido y al final se llevan al centro
  * 
  * @param tabla la tabla a ordenar
  * @param ip primer elemento de la tabla
  * @param iu último elemento de la tabla
- * @param pos pivote divisiorio sobre el cual se va a ordenar la tabla
+ * @param lt primera posición de las claves iguales al pivote
+ * @param gt última posición de las claves iguales al pivote
  * 
- * @return el número de operaciones básicas realizadas
+ * @return el número de operaciones básicas (comparaciones de clave) realizadas
 */
-int partition(int* tabla, int ip, int iu, int *pos) {
-  int i, k, n_obs;
-  n_obs = 0;
+int partition_bm(int* tabla, int ip, int iu, int *lt, int *gt) {
+  int i, j, p, q, l, k, pos, n_obs;
 
-  if(median_stat(tabla, ip, iu, pos) == ERR) {
+  if(lt == NULL || gt == NULL || median_stat(tabla, ip, iu, &pos) == ERR) {
     return ERR;
   }
 
-  k = tabla[*pos];
-
-  swap(&tabla[ip], &tabla[*pos]);
-  *pos = ip;
+  swap(&tabla[ip], &tabla[pos]);
+  k = tabla[ip];
+  n_obs = 0;
+  i = p = ip;
+  j = q = iu+1;
 
-  for (i = ip + 1; i <= iu; i++)
-  {
-    n_obs++;
-    if (tabla[i] < k)
-    {
-      (*pos)++;
-      swap(&tabla[i], &tabla[*pos]);
+  while(1) {
+    while(++i <= iu) {
+      n_obs++;
+      if(!(tabla[i] < k)) break;
     }
+    while(--j > ip) {
+      n_obs++;
+      if(!(k < tabla[j])) break;
+    }
+    if(i == j) {
+      n_obs++;
+      if(tabla[i] == k) swap(&tabla[++p], &tabla[i]);
+    }
+    if(i >= j) break;
+
+    swap(&tabla[i], &tabla[j]);
+    n_obs += 2;
+    if(tabla[i] == k) swap(&tabla[++p], &tabla[i]);
+    if(tabla[j] == k) swap(&tabla[--q], &tabla[j]);
   }
 
-  swap(&tabla[ip], &tabla[*pos]);
+  /* Lleva las claves iguales de los extremos al centro */
+  i = j+1;
+  for(l = ip; l <= p; l++) swap(&tabla[l], &tabla[j--]);
+  for(l = iu; l >= q; l--) swap(&tabla[l], &tabla[i++]);
+
+  *lt = j+1;
+  *gt = i-1;
 
   return n_obs;
 }
 
 /**
- * @brief sitúa como pivote el primer elemento de la tabla
+ * @brief sitúa como pivote el último elemento de la tabla
  * 
  * @param tabla la tabla a ordenar
  * @param ip primer elemento de la tabla
@@ -278,7 +3228,7 @@ int median(int *tabla, int ip, int iu, int *pos) {
 }
 
 /**
- * @brief sitúa como pivote el valor medio del primer elemento y el último
+ * @brief sitúa como pivote el elemento central de la tabla
  * 
  * @param tabla la tabla a ordenar
  * @param ip primer elemento de la tabla
@@ -297,8 +3247,37 @@ int median_avg(int *tabla, int ip, int iu, int *pos){
 }
 
 /**
- * @brief sitúa como pivote el valor mediano, que es el elemento situado 
- * en la posición de la mitad de una tabla ordenada
+ * @brief sitúa como pivote la mediana de las medianas de tres grupos de 
+ * tres elementos repartidos por la tabla (ninther). En tablas de menos de 
+ * NINTHER_CUTOFF elementos usa median_stat
+ * 
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param pos pivote divisiorio sobre el cual se va a ordenar la tabla
+ * 
+ * @return OK si el procedimiento se ha realizado correctamente. 
+ * ERROR si existe algún error en el procedimiento
+*/
+int median_ninther(int *tabla, int ip, int iu, int *pos) {
+  int s, m, a, b, c;
+
+  if(tabla == NULL || ip>iu) return ERR;
+
+  if(iu-ip+1 < NINTHER_CUTOFF) return median_stat(tabla, ip, iu, pos);
+
+  s = (iu-ip+1)/8;
+  m = (iu+ip)/2;
+  a = med3(tabla, ip, ip+s, ip+2*s);
+  b = med3(tabla, m-s, m, m+s);
+  c = med3(tabla, iu-2*s, iu-s, iu);
+  (*pos) = med3(tabla, a, b, c);
+
+  return OK;
+}
+
+/**
+ * @brief sitúa como pivote un elemento aleatorio de la tabla
  * 
  * @param tabla la tabla a ordenar
  * @param ip primer elemento de la tabla
@@ -308,10 +3287,72 @@ int median_avg(int *tabla, int ip, int iu, int *pos){
  * @return OK si el procedimiento se ha realizado correctamente. 
  * ERROR si existe algún error en el procedimiento
 */
-int median_stat(int *tabla, int ip, int iu, int *pos) {
+int median_random(int *tabla, int ip, int iu, int *pos) {
   if(tabla == NULL || ip>iu) return ERR;
 
-  (*pos) = (tabla[ip] + tabla[iu] + tabla[(iu+ip)/2]) / 3;
+  (*pos) = random_num(ip, iu);
 
   return OK;
-}
\ No newline at end of file
+}
+
+/* Los mismos algoritmos para otros tipos de clave. Las versiones para 
+   int de arriba son las de int32 */
+
+#define SORT_TYPE int64_t
+#define SORT_NAME(f) f##_i64
+#define SORT_PFUNC_PIVOT pfunc_pivot_i64
+#include "sorting_type.h"
+
+#define SORT_TYPE uint64_t
+#define SORT_NAME(f) f##_u64
+#define SORT_PFUNC_PIVOT pfunc_pivot_u64
+#include "sorting_type.h"
+
+#define SORT_TYPE float
+#define SORT_NAME(f) f##_f32
+#define SORT_PFUNC_PIVOT pfunc_pivot_f32
+#include "sorting_type.h"
+
+#define SORT_TYPE double
+#define SORT_NAME(f) f##_f64
+#define SORT_PFUNC_PIVOT pfunc_pivot_f64
+#include "sorting_type.h"
+
+/**
+ * @brief Intercambia dos elementos de size bytes
+ * 
+ * @param a puntero al primer elemento
+ * @param b puntero al segundo elemento
+ * @param size tamaño de los elementos en bytes
+*/
+static void swap_gen(char *a, char *b, size_t size) {
+  char x;
+
+  if(a == b) return;
+  while(size-- > 0) {
+    x = *a;
+    *a++ = *b;
+    *b++ = x;
+  }
+}
+
+/* Cualquier tipo: los elementos son bloques de size bytes que se comparan 
+   con cmp, con el mismo convenio que la de qsort */
+
+#define SORT_TYPE void
+#define SORT_NAME(f) f##_gen
+#define SORT_PFUNC_PIVOT pfunc_pivot_gen
+#define SORT_PARAMS , size_t size, pfunc_cmp cmp
+#define SORT_ARGS , size, cmp
+#define SORT_VALID (cmp != NULL && size > 0)
+#define SORT_SIZE size
+#define SORT_AT(a, i) ((char*)(a) + (size_t)(i)*size)
+#define SORT_LESS(x, y) (cmp((x), (y)) < 0)
+#define SORT_SET(x, y) memcpy((x), (y), size)
+#define SORT_SWAP(x, y) swap_gen((x), (y), size)
+#define SORT_CSWAP(x, y) do { \
+    if(SORT_LESS(y, x)) SORT_SWAP(x, y); \
+  } while(0)
+#include "sorting_type.h"
+
+
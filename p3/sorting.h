@@ -12,6 +12,9 @@
 #ifndef SORTING_H
 #define SORTING_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 /* constants */
 
 #ifndef ERR
@@ -19,8 +22,87 @@
   #define OK (!(ERR))
 #endif
 
+/* tamaño de los tramos que mergesort_bu ordena por inserción */
+#define MERGE_RUN 16
+
+/* tamaño máximo de las redes de ordenación de sortnet */
+#define NET_MAX 16
+
+/* tramos que combina a la vez mergesort_kway */
+#define MERGE_K 16
+
+/* tamaño del buffer en la pila de mergesort_inplace */
+#define INPLACE_BUF 64
+
+/* tamaño de los grupos de la mediana de medianas de quickselect */
+#define MOM_GROUP 5
+
+/* tamaño a partir del cual median_ninther usa nueve elementos */
+#define NINTHER_CUTOFF 40
+
+/* tamaño por debajo del cual introsort ordena por inserción */
+#define INTRO_CUTOFF 16
+
+/* tamaño de los bloques de partition_block (como mucho 256) */
+#define BLOCK_SIZE 64
+
+/* tamaño a partir del cual partition_simd usa AVX2 */
+#define SIMD_CUTOFF 64
+
+/* tamaño a partir del cual min usa instrucciones SIMD */
+#define SIMD_MIN_CUTOFF 32
+
+/* niveles de instrucciones SIMD que devuelve simd_level */
+#define SIMD_NONE 0
+#define SIMD_SSE41 1
+#define SIMD_AVX2 2
+
+/* timsort: victorias seguidas para galopar y altura máxima de la pila de tramos */
+#define TIM_MIN_GALLOP 7
+#define TIM_STACK 64
+
+/* dígitos de radixsort: RADIX_PASSES dígitos de RADIX_BITS bits */
+#define RADIX_BITS 8
+#define RADIX_SIZE (1 << RADIX_BITS)
+#define RADIX_PASSES 4
+#define RADIX_SIGN 0x80000000u
+
+/* tamaño por debajo del cual los ordenamientos paralelos no crean tareas */
+#define PAR_CUTOFF 16384
+
+/* separación entre los contadores de cada hilo, para no compartir línea de caché */
+#define PAR_PAD 16
+
+/* samplesort: SAMPLE_BUCKETS = 2^SAMPLE_LEVELS cubetas (como mucho 256), 
+   SAMPLE_OVERSAMPLE elementos de muestra por cubeta y tamaño mínimo */
+#define SAMPLE_LEVELS 8
+#define SAMPLE_BUCKETS (1 << SAMPLE_LEVELS)
+#define SAMPLE_OVERSAMPLE 8
+#define SAMPLE_CUTOFF (4*PAR_CUTOFF)
+
 /* type definitions */
 typedef int (* pfunc_sort)(int*, int, int);
+typedef int (* pfunc_sort_buf)(int*, int, int, int*);
+typedef int (* pfunc_pivot)(int*, int, int, int*);
+typedef int (* pfunc_cmp)(const void*, const void*);
+typedef int (* pfunc_sort_kv)(int*, int*, int, int);
+typedef int (* pfunc_pivot_i64)(int64_t*, int, int, int*);
+typedef int (* pfunc_pivot_u64)(uint64_t*, int, int, int*);
+typedef int (* pfunc_pivot_f32)(float*, int, int, int*);
+typedef int (* pfunc_pivot_f64)(double*, int, int, int*);
+typedef int (* pfunc_pivot_gen)(void*, int, int, int*, size_t, pfunc_cmp);
+
+/* árbol de perdedores de k fuentes ordenadas (ver ltree_create) */
+typedef struct ltree {
+  int k;          /* número de fuentes */
+  int *arbol;     /* arbol[0] es la ganadora y arbol[1..k) las perdedoras */
+  int *cab;       /* clave de la cabeza de cada fuente */
+  char *fin;      /* 1 si la fuente se ha agotado */
+  long n_obs;     /* comparaciones de clave realizadas */
+} LTREE, *PLTREE;
+
+/* fuente con la menor cabeza */
+#define LTREE_WINNER(t) ((t)->arbol[0])
 
 /* Functions */
 
@@ -28,13 +110,135 @@ int SelectSort(int* array, int ip, int iu);
 int SelectSortInv(int* array, int ip, int iu);
 int min(int* array, int ip, int iu);
 
+int InsertSort(int* array, int ip, int iu);
+int BinInsertSort(int* array, int ip, int iu);
+int ShellSort(int* array, int ip, int iu);
+int sortnet(int* tabla, int ip, int iu);
+int set_net_cutoff(int cutoff);
+
 int mergesort(int* tabla, int ip, int iu);
+int mergesort_buf(int* tabla, int ip, int iu, int* taux);
 int merge(int* tabla, int ip, int iu, int imedio);
+int merge_buf(int* tabla, int ip, int iu, int imedio, int* taux);
+int mergesort_bu(int* tabla, int ip, int iu);
+
+PLTREE ltree_create(int k);
+void ltree_free(PLTREE t);
+void ltree_build(PLTREE t);
+void ltree_replace(PLTREE t, int s);
+int merge_k(int** runs, int* lens, int k, int* salida);
+int mergesort_k(int* tabla, int ip, int iu, int k);
+int mergesort_kway(int* tabla, int ip, int iu);
+
+int mergesort_inplace(int* tabla, int ip, int iu);
+int mergesort_inplace_cnt(int* tabla, int ip, int iu, long *n_movs);
+
+int mergesort_par(int* tabla, int ip, int iu);
+int mergesort_par_n(int* tabla, int ip, int iu, int n_threads);
+int samplesort(int* tabla, int ip, int iu);
+int samplesort_n(int* tabla, int ip, int iu, int n_threads);
+int timsort(int* tabla, int ip, int iu);
+
+int radixsort(int* tabla, int ip, int iu);
 
 int quicksort(int* tabla, int ip, int iu);
+int quicksort_pivot(int* tabla, int ip, int iu, pfunc_pivot pivot);
+int quicksort_tail(int* tabla, int ip, int iu);
+int mergesort_kv(int* claves, int* valores, int ip, int iu);
+int quicksort_kv(int* claves, int* valores, int ip, int iu);
+int argsort_merge(int* tabla, int* perm, int ip, int iu);
+int argsort_quick(int* tabla, int* perm, int ip, int iu);
+int heapsort(int* tabla, int ip, int iu);
+int heapsort4(int* tabla, int ip, int iu);
+int heapsort_d(int* tabla, int ip, int iu, int d);
+int quicksort_par(int* tabla, int ip, int iu);
+int quicksort_par_n(int* tabla, int ip, int iu, int n_threads);
+int introsort(int* tabla, int ip, int iu);
+int quickselect(int* tabla, int ip, int iu, int k);
+int partial_sort(int* tabla, int ip, int iu, int k);
+int topk_push(int* heap, int *n_heap, int k, int x);
+int topk_sort(int* heap, int n_heap);
+int topk_heap(int* tabla, int ip, int iu, int* salida, int k);
 int partition(int* tabla, int ip, int iu,int *pos);
+int partition_pivot(int* tabla, int ip, int iu, int *pos, pfunc_pivot pivot);
+int quicksort_hoare(int* tabla, int ip, int iu);
+int partition_hoare(int* tabla, int ip, int iu, int *pos);
+int quicksort_block(int* tabla, int ip, int iu);
+int partition_block(int* tabla, int ip, int iu, int *pos);
+int simd_level(void);
+int simd_available(void);
+int quicksort_simd(int* tabla, int ip, int iu);
+int partition_simd(int* tabla, int ip, int iu, int *pos);
+int quicksort3(int* tabla, int ip, int iu);
+int partition3(int* tabla, int ip, int iu, int *lt, int *gt);
+int quicksort_bm(int* tabla, int ip, int iu);
+int partition_bm(int* tabla, int ip, int iu, int *lt, int *gt);
 int median(int *tabla, int ip, int iu, int *pos);
 int median_avg(int *tabla, int ip, int iu, int *pos);
 int median_stat(int *tabla, int ip, int iu, int *pos);
+int median_ninther(int *tabla, int ip, int iu, int *pos);
+int median_random(int *tabla, int ip, int iu, int *pos);
+
+/* Otros tipos de clave (ver sorting_type.h); int es el de int32 */
+int min_i64(int64_t* array, int ip, int iu);
+int SelectSort_i64(int64_t* array, int ip, int iu);
+int sortnet_i64(int64_t* tabla, int ip, int iu);
+int merge_buf_i64(int64_t* tabla, int ip, int iu, int imedio, int64_t* taux);
+int mergesort_buf_i64(int64_t* tabla, int ip, int iu, int64_t* taux);
+int mergesort_i64(int64_t* tabla, int ip, int iu);
+int median_stat_i64(int64_t* tabla, int ip, int iu, int *pos);
+int partition_pivot_i64(int64_t* tabla, int ip, int iu, int *pos, pfunc_pivot_i64 pivot);
+int partition_i64(int64_t* tabla, int ip, int iu, int *pos);
+int quicksort_pivot_i64(int64_t* tabla, int ip, int iu, pfunc_pivot_i64 pivot);
+int quicksort_i64(int64_t* tabla, int ip, int iu);
+
+int min_u64(uint64_t* array, int ip, int iu);
+int SelectSort_u64(uint64_t* array, int ip, int iu);
+int sortnet_u64(uint64_t* tabla, int ip, int iu);
+int merge_buf_u64(uint64_t* tabla, int ip, int iu, int imedio, uint64_t* taux);
+int mergesort_buf_u64(uint64_t* tabla, int ip, int iu, uint64_t* taux);
+int mergesort_u64(uint64_t* tabla, int ip, int iu);
+int median_stat_u64(uint64_t* tabla, int ip, int iu, int *pos);
+int partition_pivot_u64(uint64_t* tabla, int ip, int iu, int *pos, pfunc_pivot_u64 pivot);
+int partition_u64(uint64_t* tabla, int ip, int iu, int *pos);
+int quicksort_pivot_u64(uint64_t* tabla, int ip, int iu, pfunc_pivot_u64 pivot);
+int quicksort_u64(uint64_t* tabla, int ip, int iu);
+
+int min_f32(float* array, int ip, int iu);
+int SelectSort_f32(float* array, int ip, int iu);
+int sortnet_f32(float* tabla, int ip, int iu);
+int merge_buf_f32(float* tabla, int ip, int iu, int imedio, float* taux);
+int mergesort_buf_f32(float* tabla, int ip, int iu, float* taux);
+int mergesort_f32(float* tabla, int ip, int iu);
+int median_stat_f32(float* tabla, int ip, int iu, int *pos);
+int partition_pivot_f32(float* tabla, int ip, int iu, int *pos, pfunc_pivot_f32 pivot);
+int partition_f32(float* tabla, int ip, int iu, int *pos);
+int quicksort_pivot_f32(float* tabla, int ip, int iu, pfunc_pivot_f32 pivot);
+int quicksort_f32(float* tabla, int ip, int iu);
+
+int min_f64(double* array, int ip, int iu);
+int SelectSort_f64(double* array, int ip, int iu);
+int sortnet_f64(double* tabla, int ip, int iu);
+int merge_buf_f64(double* tabla, int ip, int iu, int imedio, double* taux);
+int mergesort_buf_f64(double* tabla, int ip, int iu, double* taux);
+int mergesort_f64(double* tabla, int ip, int iu);
+int median_stat_f64(double* tabla, int ip, int iu, int *pos);
+int partition_pivot_f64(double* tabla, int ip, int iu, int *pos, pfunc_pivot_f64 pivot);
+int partition_f64(double* tabla, int ip, int iu, int *pos);
+int quicksort_pivot_f64(double* tabla, int ip, int iu, pfunc_pivot_f64 pivot);
+int quicksort_f64(double* tabla, int ip, int iu);
+
+/* Cualquier tipo: tamaño del elemento y función de comparación */
+int min_gen(void* array, int ip, int iu, size_t size, pfunc_cmp cmp);
+int SelectSort_gen(void* tabla, int ip, int iu, size_t size, pfunc_cmp cmp);
+int sortnet_gen(void* tabla, int ip, int iu, size_t size, pfunc_cmp cmp);
+int merge_buf_gen(void* tabla, int ip, int iu, int imedio, void* taux, size_t size, pfunc_cmp cmp);
+int mergesort_buf_gen(void* tabla, int ip, int iu, void* taux, size_t size, pfunc_cmp cmp);
+int mergesort_gen(void* tabla, int ip, int iu, size_t size, pfunc_cmp cmp);
+int median_stat_gen(void* tabla, int ip, int iu, int *pos, size_t size, pfunc_cmp cmp);
+int partition_pivot_gen(void* tabla, int ip, int iu, int *pos, pfunc_pivot_gen pivot, size_t size, pfunc_cmp cmp);
+int partition_gen(void* tabla, int ip, int iu, int *pos, size_t size, pfunc_cmp cmp);
+int quicksort_pivot_gen(void* tabla, int ip, int iu, pfunc_pivot_gen pivot, size_t size, pfunc_cmp cmp);
+int quicksort_gen(void* tabla, int ip, int iu, size_t size, pfunc_cmp cmp);
 
 #endif
@@ -0,0 +1,421 @@
+/**
+ *
+ * Descripcion: Template of SelectSort, sortnet, mergesort and quicksort
+ * for one key type. It is included by sorting.c once per type, with no
+ * include guard
+ *
+ * Fichero: sorting_type.h
+ * Autor: Eduardo Junoy y Miguel Lozano
+ * Version: 1.0
+ * Fecha: 17-10-2026
+ *
+ */
+
+/* Antes de incluir este fichero hay que definir:
+     SORT_TYPE         tipo de las claves (void para las genéricas)
+     SORT_NAME(f)      nombre de la función f para ese tipo, p. ej. f##_i64
+     SORT_PFUNC_PIVOT  tipo de las funciones de selección del pivote
+   y, si los valores por defecto no sirven para el tipo:
+     SORT_PARAMS, SORT_ARGS  parámetros extra de todas las funciones
+                       (declaración y llamada), precedidos de coma
+     SORT_VALID        condición que deben cumplir los parámetros extra
+     SORT_SIZE         tamaño de una clave en bytes
+     SORT_AT(a, i)     puntero a la clave i de a
+     SORT_LESS(x, y)   1 si la clave *x es menor que la *y
+     SORT_SET(x, y)    copia la clave *y en *x
+     SORT_SWAP(x, y)   intercambia las claves *x y *y
+     SORT_CSWAP(x, y)  comparador de las redes: deja en *x la menor y en
+                       *y la mayor
+     SORT_MIN_SIMD(a, ip, iu)  opcional: índice del primer mínimo de
+                       a[ip..iu] con instrucciones SIMD, o ERR si no se
+                       pueden usar
+   También se usan net_pares, net_inicio y net_cutoff de sorting.c, que
+   son los mismos para todos los tipos. Al final se eliminan todas estas
+   macros para poder incluir el fichero otra vez con otro tipo */
+
+#if !defined(SORT_TYPE) || !defined(SORT_NAME) || !defined(SORT_PFUNC_PIVOT)
+  #error "SORT_TYPE, SORT_NAME y SORT_PFUNC_PIVOT deben estar definidos"
+#endif
+
+#ifndef SORT_PARAMS
+  #define SORT_PARAMS
+  #define SORT_ARGS
+#endif
+#ifndef SORT_VALID
+  #define SORT_VALID 1
+#endif
+#ifndef SORT_SIZE
+  #define SORT_SIZE sizeof(SORT_TYPE)
+#endif
+#ifndef SORT_AT
+  #define SORT_AT(a, i) (&(a)[i])
+#endif
+#ifndef SORT_LESS
+  #define SORT_LESS(x, y) (*(x) < *(y))
+#endif
+#ifndef SORT_SET
+  #define SORT_SET(x, y) (*(x) = *(y))
+#endif
+#ifndef SORT_SWAP
+  #define SORT_SWAP(x, y) do { \
+      SORT_TYPE sort_tmp = *(x); \
+      *(x) = *(y); \
+      *(y) = sort_tmp; \
+    } while(0)
+#endif
+#ifndef SORT_CSWAP
+  /* mínimo y máximo sin saltos condicionales */
+  #define SORT_CSWAP(x, y) do { \
+      SORT_TYPE sort_x = *(x), sort_y = *(y); \
+      int sort_menor = (sort_x < sort_y); \
+      *(x) = sort_menor ? sort_x : sort_y; \
+      *(y) = sort_menor ? sort_y : sort_x; \
+    } while(0)
+#endif
+
+/**
+ * @brief Localiza el menor elemento de un array. Si el tipo tiene
+ * SORT_MIN_SIMD lo intenta primero; en caso de empate devuelve siempre el
+ * primero, igual que el recorrido escalar
+ *
+ * @param array el array en el que busca
+ * @param ip primer índice del array
+ * @param iu último índice del array
+ *
+ * @return el índice del primer menor elemento del array
+*/
+int SORT_NAME(min)(SORT_TYPE* array, int ip, int iu SORT_PARAMS)
+{
+  int i, min;
+
+#ifdef SORT_MIN_SIMD
+  min = SORT_MIN_SIMD(array, ip, iu);
+  if(min != ERR) return min;
+#endif
+
+  min = ip;
+  for(i = ip+1; i <= iu; i++) {
+    if(SORT_LESS(SORT_AT(array, i), SORT_AT(array, min))) min = i;
+  }
+
+  return min;
+}
+
+/**
+ * @brief Ordena de menor a mayor un array por selección
+ *
+ * @param array el array a ordenar
+ * @param ip primer índice del array
+ * @param iu último índice del array
+ *
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int SORT_NAME(SelectSort)(SORT_TYPE* array, int ip, int iu SORT_PARAMS)
+{
+  int i, minimum, count;
+
+  if(array == NULL || !(SORT_VALID) || ip > iu) return ERR;
+
+  count = 0;
+  for(i = ip; i < iu; i++) {
+    minimum = SORT_NAME(min)(array, i, iu SORT_ARGS);
+    count += iu-i;
+    SORT_SWAP(SORT_AT(array, i), SORT_AT(array, minimum));
+  }
+
+  return count;
+}
+
+/**
+ * @brief Ordena de menor a mayor un tramo de como mucho NET_MAX elementos
+ * con una red de ordenación. El número de comparaciones sólo depende del
+ * tamaño
+ *
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla (iu-ip+1 <= NET_MAX)
+ *
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int SORT_NAME(sortnet)(SORT_TYPE* tabla, int ip, int iu SORT_PARAMS)
+{
+  int n, c;
+
+  if(tabla == NULL || !(SORT_VALID) || ip > iu || iu-ip+1 > NET_MAX) return ERR;
+
+  n = iu-ip+1;
+  for(c = net_inicio[n]; c < net_inicio[n+1]; c++) {
+    SORT_CSWAP(SORT_AT(tabla, ip + net_pares[c][0]), SORT_AT(tabla, ip + net_pares[c][1]));
+  }
+
+  return net_inicio[n+1] - net_inicio[n];
+}
+
+/**
+ * @brief Combina las dos subtablas en la tabla auxiliar dada y esta la copia en la tabla original
+ *
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param imedio último elemento de la primera subtabla
+ * @param taux tabla auxiliar de al menos iu-ip+1 elementos
+ *
+ * @return el número de operaciones básicas realizadas
+*/
+int SORT_NAME(merge_buf)(SORT_TYPE* tabla, int ip, int iu, int imedio, SORT_TYPE* taux SORT_PARAMS)
+{
+  int i, j, k, n_obs;
+
+  n_obs = 0;
+  for(i = ip, j = imedio+1, k = 0; i <= imedio && j <= iu; k++) {
+    n_obs++;
+    if(SORT_LESS(SORT_AT(tabla, i), SORT_AT(tabla, j))) {
+      SORT_SET(SORT_AT(taux, k), SORT_AT(tabla, i));
+      i++;
+    }
+    else {
+      SORT_SET(SORT_AT(taux, k), SORT_AT(tabla, j));
+      j++;
+    }
+  }
+
+  /* Sólo queda uno de los dos tramos */
+  if(i <= imedio) memcpy(SORT_AT(taux, k), SORT_AT(tabla, i), SORT_SIZE * (imedio-i+1));
+  else memcpy(SORT_AT(taux, k), SORT_AT(tabla, j), SORT_SIZE * (iu-j+1));
+
+  memcpy(SORT_AT(tabla, ip), taux, SORT_SIZE * (iu-ip+1));
+
+  return n_obs;
+}
+
+/**
+ * @brief Ordena de menor a mayor una tabla usando una tabla auxiliar
+ * proporcionada por el llamante. Los tramos de net_cutoff elementos o
+ * menos se ordenan con sortnet
+ *
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param taux tabla auxiliar de al menos iu-ip+1 elementos
+ *
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int SORT_NAME(mergesort_buf)(SORT_TYPE* tabla, int ip, int iu, SORT_TYPE* taux SORT_PARAMS)
+{
+  int medio, n_obs, st;
+
+  if(tabla == NULL || taux == NULL || !(SORT_VALID) || ip > iu) return ERR;
+
+  if(ip == iu) return 0;
+  if(iu-ip+1 <= net_cutoff) return SORT_NAME(sortnet)(tabla, ip, iu SORT_ARGS);
+
+  medio = (ip+iu)/2;
+  n_obs = SORT_NAME(mergesort_buf)(tabla, ip, medio, taux SORT_ARGS);
+  if(n_obs == ERR) return ERR;
+  st = SORT_NAME(mergesort_buf)(tabla, medio+1, iu, taux SORT_ARGS);
+  if(st == ERR) return ERR;
+  n_obs += st;
+
+  n_obs += SORT_NAME(merge_buf)(tabla, ip, iu, medio, taux SORT_ARGS);
+  return n_obs;
+}
+
+/**
+ * @brief Ordena de menor a mayor una tabla con mergesort. Reserva una
+ * única tabla auxiliar para toda la recursión en lugar de una por cada
+ * merge
+ *
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ *
+ * @return el número de operaciones básicas (comparaciones de clave) que ha realizado el algortimo
+*/
+int SORT_NAME(mergesort)(SORT_TYPE* tabla, int ip, int iu SORT_PARAMS)
+{
+  SORT_TYPE *taux;
+  int n_obs;
+
+  if(tabla == NULL || !(SORT_VALID) || ip > iu) return ERR;
+
+  taux = (SORT_TYPE*)malloc(SORT_SIZE * (iu+1-ip));
+  if(taux == NULL) return ERR;
+
+  n_obs = SORT_NAME(mergesort_buf)(tabla, ip, iu, taux SORT_ARGS);
+
+  free(taux);
+  return n_obs;
+}
+
+/**
+ * @brief Devuelve la posición del valor mediano de tres elementos
+ *
+ * @param tabla la tabla
+ * @param a primera posición
+ * @param b segunda posición
+ * @param c tercera posición
+ *
+ * @return la posición del valor mediano
+*/
+static int SORT_NAME(med3)(SORT_TYPE *tabla, int a, int b, int c SORT_PARAMS)
+{
+  if(SORT_LESS(SORT_AT(tabla, a), SORT_AT(tabla, b))) {
+    if(SORT_LESS(SORT_AT(tabla, b), SORT_AT(tabla, c))) return b;
+    return SORT_LESS(SORT_AT(tabla, a), SORT_AT(tabla, c)) ? c : a;
+  }
+  if(SORT_LESS(SORT_AT(tabla, a), SORT_AT(tabla, c))) return a;
+  return SORT_LESS(SORT_AT(tabla, b), SORT_AT(tabla, c)) ? c : b;
+}
+
+/**
+ * @brief sitúa como pivote la mediana del primer elemento, el central
+ * y el último de la tabla
+ *
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param pos pivote divisiorio sobre el cual se va a ordenar la tabla
+ *
+ * @return OK si el procedimiento se ha realizado correctamente.
+ * ERROR si existe algún error en el procedimiento
+*/
+int SORT_NAME(median_stat)(SORT_TYPE *tabla, int ip, int iu, int *pos SORT_PARAMS)
+{
+  if(tabla == NULL || pos == NULL || !(SORT_VALID) || ip > iu) return ERR;
+
+  *pos = SORT_NAME(med3)(tabla, ip, (iu+ip)/2, iu SORT_ARGS);
+
+  return OK;
+}
+
+/**
+ * @brief realiza una partición en dos respecto al elemento de la posición
+ * *pos, que es donde queda el pivote al terminar
+ *
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param pos posición del pivote, antes y después de la partición
+ *
+ * @return el número de operaciones básicas realizadas
+*/
+static int SORT_NAME(partition_at)(SORT_TYPE* tabla, int ip, int iu, int *pos SORT_PARAMS)
+{
+  int i, n_obs;
+
+  /* El pivote queda en ip mientras se recorre la tabla */
+  SORT_SWAP(SORT_AT(tabla, ip), SORT_AT(tabla, *pos));
+  *pos = ip;
+
+  n_obs = 0;
+  for(i = ip+1; i <= iu; i++) {
+    n_obs++;
+    if(SORT_LESS(SORT_AT(tabla, i), SORT_AT(tabla, ip))) {
+      (*pos)++;
+      SORT_SWAP(SORT_AT(tabla, i), SORT_AT(tabla, *pos));
+    }
+  }
+
+  SORT_SWAP(SORT_AT(tabla, ip), SORT_AT(tabla, *pos));
+
+  return n_obs;
+}
+
+/**
+ * @brief realiza una partición en dos respecto al pivote elegido por
+ * la función dada
+ *
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param pos pivote divisiorio sobre el cual se va a ordenar la tabla
+ * @param pivot función de selección del pivote
+ *
+ * @return el número de operaciones básicas realizadas
+*/
+int SORT_NAME(partition_pivot)(SORT_TYPE* tabla, int ip, int iu, int *pos, SORT_PFUNC_PIVOT pivot SORT_PARAMS)
+{
+  if(pivot == NULL || pivot(tabla, ip, iu, pos SORT_ARGS) == ERR) return ERR;
+
+  return SORT_NAME(partition_at)(tabla, ip, iu, pos SORT_ARGS);
+}
+
+/**
+ * @brief realiza una partición en dos con el pivote de median_stat
+ *
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param pos pivote divisiorio sobre el cual se va a ordenar la tabla
+ *
+ * @return el número de operaciones básicas realizadas
+*/
+int SORT_NAME(partition)(SORT_TYPE* tabla, int ip, int iu, int *pos SORT_PARAMS)
+{
+  return SORT_NAME(partition_pivot)(tabla, ip, iu, pos, SORT_NAME(median_stat) SORT_ARGS);
+}
+
+/**
+ * @brief Ordena la tabla con quicksort eligiendo el pivote de cada
+ * partición con la función dada. Los tramos de net_cutoff elementos o
+ * menos se ordenan con sortnet
+ *
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ * @param pivot función de selección del pivote
+ *
+ * @return el número de operaciones básicas realizadas
+*/
+int SORT_NAME(quicksort_pivot)(SORT_TYPE* tabla, int ip, int iu, SORT_PFUNC_PIVOT pivot SORT_PARAMS)
+{
+  int pos, n_obs, st;
+
+  if(tabla == NULL || !(SORT_VALID) || ip > iu) return ERR;
+  if(ip == iu) return 0;
+  if(iu-ip+1 <= net_cutoff) return SORT_NAME(sortnet)(tabla, ip, iu SORT_ARGS);
+
+  n_obs = SORT_NAME(partition_pivot)(tabla, ip, iu, &pos, pivot SORT_ARGS);
+  if(n_obs == ERR) return ERR;
+
+  if(ip < pos-1) {
+    st = SORT_NAME(quicksort_pivot)(tabla, ip, pos-1, pivot SORT_ARGS);
+    if(st == ERR) return ERR;
+    n_obs += st;
+  }
+  if(pos+1 < iu) {
+    st = SORT_NAME(quicksort_pivot)(tabla, pos+1, iu, pivot SORT_ARGS);
+    if(st == ERR) return ERR;
+    n_obs += st;
+  }
+
+  return n_obs;
+}
+
+/**
+ * @brief Ordena la tabla con quicksort y el pivote de median_stat
+ *
+ * @param tabla la tabla a ordenar
+ * @param ip primer elemento de la tabla
+ * @param iu último elemento de la tabla
+ *
+ * @return el número de operaciones básicas realizadas
+*/
+int SORT_NAME(quicksort)(SORT_TYPE* tabla, int ip, int iu SORT_PARAMS)
+{
+  return SORT_NAME(quicksort_pivot)(tabla, ip, iu, SORT_NAME(median_stat) SORT_ARGS);
+}
+
+#undef SORT_TYPE
+#undef SORT_NAME
+#undef SORT_PFUNC_PIVOT
+#undef SORT_PARAMS
+#undef SORT_ARGS
+#undef SORT_VALID
+#undef SORT_SIZE
+#undef SORT_AT
+#undef SORT_LESS
+#undef SORT_SET
+#undef SORT_SWAP
+#undef SORT_CSWAP
+#undef SORT_MIN_SIMD
@@ -37,12 +37,14 @@ short average_sorting_time(pfunc_sort metodo,
   ptime->N = N;
   ptime->n_elems = n_perms;
   ptime->min_ob = ptime->max_ob = ptime->average_ob = 0;
+  ptime->average_swaps = 0;
 
   permutaciones = generate_permutations(n_perms, N);
   if(permutaciones == NULL){
     return ERR;
   }
 
+  reset_swap_count();
   ini = clock();
   for (i = 0; i < n_perms; i++)
   {
@@ -68,6 +70,7 @@ short average_sorting_time(pfunc_sort metodo,
 
   ptime->time = (double)(fin-ini)/CLOCKS_PER_SEC/n_perms;
   ptime->average_ob /= n_perms;
+  ptime->average_swaps = (double)swap_count()/n_perms;
 
   for(i=0; i<n_perms; i++)
   {
@@ -122,6 +125,7 @@ short generate_sorting_times(pfunc_sort method, char* file,
     times[i].average_ob = p_time->average_ob;
     times[i].max_ob = p_time->max_ob;
     times[i].min_ob = p_time->min_ob;
+    times[i].average_swaps = p_time->average_swaps;
   }
   if(save_time_table(file, times, n_times) == ERR) {
     free(p_time);
@@ -152,7 +156,7 @@ short save_time_table(char* file, PTIME_AA ptime, int n_times)
 
   for(i=0; n_times > 0; i++, n_times--)
   {
-    fprintf(pf,"%d  %.10f  %.2f  %d  %d\n", ptime[i].N, ptime[i].time, ptime[i].average_ob, ptime[i].max_ob, ptime[i].min_ob);
+    fprintf(pf,"%d  %.10f  %.2f  %d  %d  %.2f\n", ptime[i].N, ptime[i].time, ptime[i].average_ob, ptime[i].max_ob, ptime[i].min_ob, ptime[i].average_swaps);
   }
   
   fclose(pf);
@@ -209,6 +213,7 @@ short average_search_time(pfunc_search metodo, pfunc_key_generator generator, in
   ptime->min_ob = INT_MAX;
   ptime->average_ob = 0;
   obs = 0;
+  reset_swap_count();
   ini = clock();
   for(i = 0; i < (N * n_times); i++) {
     obs = metodo(dic->table, 0, dic->n_data-1, keys_to_search[i], &pos);
@@ -232,6 +237,7 @@ short average_search_time(pfunc_search metodo, pfunc_key_generator generator, in
   ptime->n_elems = N * n_times;
   ptime->time = (double)(fin-ini)/CLOCKS_PER_SEC/ptime->n_elems;
   ptime->average_ob /= ptime->n_elems;
+  ptime->average_swaps = (double)swap_count()/ptime->n_elems;
 
   free_dictionary(dic);
   free(perm);
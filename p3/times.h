@@ -30,6 +30,7 @@ typedef struct time_aa {
   double average_ob; /* average number of times that the OB is executed */
   int min_ob;      /* minimum of executions of the OB */
   int max_ob;      /* maximum of executions of the OB */
+  double average_swaps; /* average number of swaps */
 } TIME_AA, *PTIME_AA;
 
 